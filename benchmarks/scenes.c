@@ -0,0 +1,581 @@
+#define ROCKS_CLAY_IMPLEMENTATION
+#include "rocks_clay.h"
+#include "rocks_types.h"
+#include "rocks.h"
+#include "rocks_custom.h"
+#include "components/grid.h"
+#include "components/markdown.h"
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+// Synthetic stress scenes run through the headless backend. Each scene runs
+// in its own process so Clay, the caches and peak RSS start fresh, and
+// prints one JSON object of per-frame percentiles.
+//
+//     scenes [frames] [scene]
+
+#ifndef ROCKS_USE_HEADLESS
+#error "Benchmarks run on the headless backend, build with make bench"
+#endif
+
+#define WARMUP_FRAMES 10
+#define DEFAULT_FRAMES 200
+#define MAX_ELEMENTS (1 << 17)
+#define MAX_CACHED_WORDS (1 << 18)
+
+enum {
+    FONT_TITLE = 0,
+    FONT_BODY = 1,
+    FONT_CODE = 2
+};
+
+// Allocation tracking, wired in with -Wl,--wrap for malloc and friends
+static uint64_t g_allocations = 0;
+static size_t g_heap_bytes = 0;
+static size_t g_heap_peak = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static void TrackAllocation(void* ptr) {
+    if (!ptr) return;
+    g_allocations++;
+    g_heap_bytes += malloc_usable_size(ptr);
+    if (g_heap_bytes > g_heap_peak) g_heap_peak = g_heap_bytes;
+}
+
+void* __wrap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    TrackAllocation(ptr);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    TrackAllocation(ptr);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+    void* grown = __real_realloc(ptr, size);
+    if (grown) {
+        g_heap_bytes -= old_size;
+        TrackAllocation(grown);
+    }
+    return grown;
+}
+
+void __wrap_free(void* ptr) {
+    if (ptr) g_heap_bytes -= malloc_usable_size(ptr);
+    __real_free(ptr);
+}
+
+static double Now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Per-frame samples for the running scene
+typedef struct {
+    int frames;
+    double* layout;
+    double* render;
+    uint64_t* allocations;
+    uint64_t* commands;
+
+    double layout_start;
+    double layout_end;
+    uint64_t frame_allocations;
+} BenchSamples;
+
+static BenchSamples g_samples;
+
+static void OnFrame(Clay_RenderCommandArray commands, uint32_t frame, void* userData) {
+    double now = Now();
+    if (frame >= WARMUP_FRAMES) {
+        int i = frame - WARMUP_FRAMES;
+        g_samples.layout[i] = g_samples.layout_end - g_samples.layout_start;
+        g_samples.render[i] = now - g_samples.layout_end;
+        g_samples.allocations[i] = g_allocations - g_samples.frame_allocations;
+        g_samples.commands[i] = commands.length;
+    }
+    g_samples.frame_allocations = g_allocations;
+}
+
+// Scenes
+
+static Rocks_Theme g_theme;
+static char (*g_labels)[24] = NULL;
+static int g_label_count = 0;
+static Rocks_Markdown* g_markdown = NULL;
+static Rocks_Grid* g_grid = NULL;
+
+static void PrepareLabels(int count, const char* prefix) {
+    g_labels = malloc(count * sizeof(*g_labels));
+    g_label_count = count;
+    for (int i = 0; i < count; i++) {
+        snprintf(g_labels[i], sizeof(g_labels[i]), "%s %d", prefix, i);
+    }
+}
+
+static Clay_String Label(int index) {
+    return (Clay_String){ .length = strlen(g_labels[index]), .chars = g_labels[index] };
+}
+
+static Clay_RenderCommandArray SceneTextLabels(Rocks* rocks, float dt) {
+    Clay_BeginLayout();
+
+    CLAY({
+        .id = CLAY_ID("LabelScroll"),
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .padding = CLAY_PADDING_ALL(8),
+            .childGap = 4
+        },
+        .backgroundColor = g_theme.background,
+        .scroll = { .vertical = true, .horizontal = true }
+    }) {
+        for (int row = 0; row < g_label_count / 100; row++) {
+            CLAY({ .layout = { .layoutDirection = CLAY_LEFT_TO_RIGHT, .childGap = 8 } }) {
+                for (int col = 0; col < 100; col++) {
+                    CLAY_TEXT(Label(row * 100 + col), CLAY_TEXT_CONFIG({
+                        .textColor = g_theme.text,
+                        .fontSize = 14,
+                        .fontId = FONT_BODY
+                    }));
+                }
+            }
+        }
+    }
+
+    return Clay_EndLayout();
+}
+
+static Clay_RenderCommandArray SceneCards(Rocks* rocks, float dt) {
+    Clay_BeginLayout();
+
+    CLAY({
+        .id = CLAY_ID("CardScroll"),
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .padding = CLAY_PADDING_ALL(16),
+            .childGap = 16
+        },
+        .backgroundColor = g_theme.background,
+        .scroll = { .vertical = true }
+    }) {
+        for (int row = 0; row < g_label_count / 20; row++) {
+            CLAY({ .layout = { .layoutDirection = CLAY_LEFT_TO_RIGHT, .childGap = 16 } }) {
+                for (int col = 0; col < 20; col++) {
+                    CLAY({
+                        .layout = {
+                            .sizing = { CLAY_SIZING_FIXED(120), CLAY_SIZING_FIXED(80) },
+                            .padding = CLAY_PADDING_ALL(12),
+                            .childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER }
+                        },
+                        .backgroundColor = g_theme.secondary,
+                        .cornerRadius = CLAY_CORNER_RADIUS(8),
+                        .border = { .width = CLAY_BORDER_ALL(1), .color = g_theme.border },
+                        .userData = Rocks_AllocateCustomData((RocksCustomData) {
+                            .shadowEnabled = true,
+                            .shadowColor = { 0, 0, 0, 120 },
+                            .shadowOffset = { 0, 4 },
+                            .shadowBlurRadius = 8,
+                            .shadowSpread = 0
+                        })
+                    }) {
+                        CLAY_TEXT(Label(row * 20 + col), CLAY_TEXT_CONFIG({
+                            .textColor = g_theme.text,
+                            .fontSize = 14,
+                            .fontId = FONT_BODY
+                        }));
+                    }
+                }
+            }
+        }
+    }
+
+    return Clay_EndLayout();
+}
+
+static void NestedScroll(int depth) {
+    if (depth >= g_label_count) return;
+
+    CLAY({
+        .id = CLAY_IDI("NestedScroll", depth),
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            .padding = CLAY_PADDING_ALL(4),
+            .childGap = 4
+        },
+        .backgroundColor = depth % 2 ? g_theme.secondary : g_theme.background,
+        .border = { .width = CLAY_BORDER_ALL(1), .color = g_theme.border },
+        .scroll = { .vertical = true }
+    }) {
+        CLAY_TEXT(Label(depth), CLAY_TEXT_CONFIG({
+            .textColor = g_theme.text,
+            .fontSize = 14,
+            .fontId = FONT_BODY
+        }));
+        NestedScroll(depth + 1);
+    }
+}
+
+static Clay_RenderCommandArray SceneNestedScroll(Rocks* rocks, float dt) {
+    Clay_BeginLayout();
+    NestedScroll(0);
+    return Clay_EndLayout();
+}
+
+static Clay_RenderCommandArray SceneMarkdown(Rocks* rocks, float dt) {
+    Clay_BeginLayout();
+
+    CLAY({
+        .id = CLAY_ID("MarkdownScroll"),
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .padding = CLAY_PADDING_ALL(20)
+        },
+        .backgroundColor = g_theme.background,
+        .scroll = { .vertical = true }
+    }) {
+        Rocks_RenderMarkdown(g_markdown);
+    }
+
+    return Clay_EndLayout();
+}
+
+static void RenderGridItem(void* data) {
+    int index = (int)(intptr_t)data;
+
+    CLAY({
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .childAlignment = { CLAY_ALIGN_X_CENTER, CLAY_ALIGN_Y_CENTER },
+            .padding = CLAY_PADDING_ALL(8)
+        },
+        .backgroundColor = g_theme.secondary,
+        .cornerRadius = CLAY_CORNER_RADIUS(6)
+    }) {
+        CLAY_TEXT(Label(index), CLAY_TEXT_CONFIG({
+            .textColor = g_theme.text,
+            .fontSize = 14,
+            .fontId = FONT_BODY
+        }));
+    }
+}
+
+static Clay_RenderCommandArray SceneGrid(Rocks* rocks, float dt) {
+    Clay_BeginLayout();
+
+    CLAY({
+        .id = CLAY_ID("GridScroll"),
+        .layout = {
+            .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_GROW(0) },
+            .layoutDirection = CLAY_TOP_TO_BOTTOM
+        },
+        .backgroundColor = g_theme.background,
+        .scroll = { .vertical = true }
+    }) {
+        Rocks_BeginGrid(g_grid);
+        for (int i = 0; i < g_grid->itemCount; i++) {
+            Rocks_RenderGridItem(g_grid, i, RenderGridItem);
+        }
+        Rocks_EndGrid(g_grid);
+    }
+
+    return Clay_EndLayout();
+}
+
+// Rocks_Dropdown holds at most ROCKS_MAX_DROPDOWN_OPTIONS options, so this
+// builds the same open option list directly
+static Clay_RenderCommandArray SceneDropdown(Rocks* rocks, float dt) {
+    Clay_BeginLayout();
+
+    CLAY({
+        .id = CLAY_ID("BenchDropdown"),
+        .layout = {
+            .sizing = { CLAY_SIZING_FIXED(300), CLAY_SIZING_FIXED(40) },
+            .padding = CLAY_PADDING_ALL(8),
+            .childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER }
+        },
+        .backgroundColor = g_theme.secondary,
+        .cornerRadius = CLAY_CORNER_RADIUS(4),
+        .border = { .width = CLAY_BORDER_ALL(1), .color = g_theme.primary }
+    }) {
+        CLAY_TEXT(Label(0), CLAY_TEXT_CONFIG({
+            .textColor = g_theme.text,
+            .fontSize = 16,
+            .fontId = FONT_BODY
+        }));
+
+        CLAY({
+            .id = CLAY_ID("BenchDropdownOptions"),
+            .layout = {
+                .sizing = { CLAY_SIZING_FIXED(300), CLAY_SIZING_FIXED(600) },
+                .layoutDirection = CLAY_TOP_TO_BOTTOM
+            },
+            .backgroundColor = g_theme.secondary,
+            .cornerRadius = CLAY_CORNER_RADIUS(4),
+            .border = { .width = CLAY_BORDER_ALL(1), .color = g_theme.border },
+            .floating = {
+                .offset = { .x = 0, .y = 44 },
+                .attachTo = CLAY_ATTACH_TO_PARENT
+            },
+            .scroll = { .vertical = true }
+        }) {
+            for (int i = 0; i < g_label_count; i++) {
+                CLAY({
+                    .id = CLAY_IDI("BenchDropdownOption", i),
+                    .layout = {
+                        .sizing = { CLAY_SIZING_GROW(0), CLAY_SIZING_FIXED(32) },
+                        .padding = CLAY_PADDING_ALL(8),
+                        .childAlignment = { CLAY_ALIGN_X_LEFT, CLAY_ALIGN_Y_CENTER }
+                    },
+                    .backgroundColor = Clay_Hovered() ? g_theme.primary_hover : g_theme.secondary
+                }) {
+                    CLAY_TEXT(Label(i), CLAY_TEXT_CONFIG({
+                        .textColor = g_theme.text,
+                        .fontSize = 16,
+                        .fontId = FONT_BODY
+                    }));
+                }
+            }
+        }
+    }
+
+    return Clay_EndLayout();
+}
+
+// About 1 MB of headings, paragraphs, lists and code blocks
+static char* GenerateMarkdown(size_t target) {
+    static const char* paragraph =
+        "Rocks lays out every element with Clay each frame and draws the "
+        "result with **SDL2** or *raylib*. This paragraph repeats to give the "
+        "markdown renderer a long document with `inline code` and "
+        "[links](https://example.com) to lay out.\n\n";
+    static const char* list =
+        "- First item of a bullet list\n"
+        "- Second item with **bold** text\n"
+        "- Third item with `code`\n\n";
+    static const char* code =
+        "```c\n"
+        "for (int i = 0; i < count; i++) {\n"
+        "    total += values[i];\n"
+        "}\n"
+        "```\n\n";
+
+    char* text = malloc(target + 1024);
+    if (!text) return NULL;
+
+    size_t length = 0;
+    for (int section = 0; length < target; section++) {
+        length += sprintf(text + length, "## Section %d\n\n", section);
+        length += sprintf(text + length, "%s%s%s%s", paragraph, list, paragraph, code);
+    }
+    return text;
+}
+
+typedef struct {
+    const char* name;
+    Rocks_UpdateFunction update;
+    int labels;
+} BenchScene;
+
+static const BenchScene g_scenes[] = {
+    { "text_labels_10k", SceneTextLabels, 10000 },
+    { "rounded_cards_2k", SceneCards, 2000 },
+    { "nested_scroll_100", SceneNestedScroll, 100 },
+    { "markdown_1mb", SceneMarkdown, 0 },
+    { "grid_10k", SceneGrid, 10000 },
+    { "dropdown_1000", SceneDropdown, 1000 }
+};
+
+static void PrepareScene(const BenchScene* scene) {
+    PrepareLabels(scene->labels > 0 ? scene->labels : 1, "Item");
+
+    if (scene->update == SceneMarkdown) {
+        g_markdown = Rocks_CreateMarkdownViewer(FONT_BODY, FONT_CODE);
+        char* text = GenerateMarkdown(1024 * 1024);
+        Rocks_LoadMarkdownFromString(g_markdown, text);
+        free(text);
+    } else if (scene->update == SceneGrid) {
+        g_grid = Rocks_CreateGrid();
+        Rocks_InitGrid(g_grid, (Rocks_GridConfig){
+            .width = 120,
+            .height = 80,
+            .gap = 8,
+            .padding = 8
+        });
+        for (int i = 0; i < scene->labels; i++) {
+            Rocks_AddGridItem(g_grid, (void*)(intptr_t)i);
+        }
+    }
+}
+
+static int CompareDoubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts `values` in place; `scale` converts them to the reported unit
+static void Percentiles(FILE* out, const char* key, double* values, int count, double scale) {
+    qsort(values, count, sizeof(double), CompareDoubles);
+
+    double sum = 0;
+    for (int i = 0; i < count; i++) sum += values[i];
+
+    fprintf(out, "\"%s\":{\"mean\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"p99\":%.4f,\"max\":%.4f}",
+            key,
+            sum / count * scale,
+            values[count * 50 / 100] * scale,
+            values[count * 90 / 100] * scale,
+            values[count * 99 / 100] * scale,
+            values[count - 1] * scale);
+}
+
+static Rocks_UpdateFunction g_scene_update = NULL;
+
+static Clay_RenderCommandArray TimedUpdate(Rocks* rocks, float dt) {
+    g_samples.layout_start = Now();
+    Clay_RenderCommandArray commands = g_scene_update(rocks, dt);
+    g_samples.layout_end = Now();
+    return commands;
+}
+
+static int RunScene(const BenchScene* scene, int frames) {
+    g_samples = (BenchSamples){
+        .frames = frames,
+        .layout = calloc(frames, sizeof(double)),
+        .render = calloc(frames, sizeof(double)),
+        .allocations = calloc(frames, sizeof(uint64_t)),
+        .commands = calloc(frames, sizeof(uint64_t))
+    };
+    if (!g_samples.layout || !g_samples.render || !g_samples.allocations || !g_samples.commands) return 1;
+
+    // Point at the middle of the window and scroll a little every frame
+    Rocks_HeadlessEvent* events = calloc(WARMUP_FRAMES + frames + 1, sizeof(Rocks_HeadlessEvent));
+    if (!events) return 1;
+    events[0] = (Rocks_HeadlessEvent){ .frame = 0, .type = ROCKS_HEADLESS_EVENT_MOUSE_MOVE, .x = 400, .y = 300 };
+    for (int i = 0; i < WARMUP_FRAMES + frames; i++) {
+        events[i + 1] = (Rocks_HeadlessEvent){ .frame = i, .type = ROCKS_HEADLESS_EVENT_WHEEL, .y = -20 };
+    }
+
+    Rocks_HeadlessConfig headless_config = {
+        .max_frames = WARMUP_FRAMES + frames,
+        .events = events,
+        .event_count = WARMUP_FRAMES + frames + 1,
+        .on_frame = OnFrame
+    };
+
+    g_theme = Rocks_ThemeDefault();
+    Rocks_Config config = {
+        .window_width = 800,
+        .window_height = 600,
+        .window_title = scene->name,
+        .theme = g_theme,
+        .scale_factor = 1.0f,
+        .max_element_count = MAX_ELEMENTS,
+        .max_text_word_count = MAX_CACHED_WORDS,
+        .renderer_config = &headless_config
+    };
+
+    Rocks* rocks = Rocks_Init(config);
+    if (!rocks) return 1;
+
+    Rocks_LoadFont("assets/Roboto-Bold.ttf", 32, FONT_TITLE);
+    Rocks_LoadFont("assets/Roboto-Regular.ttf", 16, FONT_BODY);
+    Rocks_LoadFont("assets/RobotoMono-Regular.ttf", 14, FONT_CODE);
+
+    PrepareScene(scene);
+
+    size_t setup_heap = g_heap_bytes;
+    g_heap_peak = g_heap_bytes;
+    g_samples.frame_allocations = g_allocations;
+    g_scene_update = scene->update;
+
+    Rocks_Run(rocks, TimedUpdate);
+
+    size_t heap_peak = g_heap_peak;
+    size_t frame_arena_peak = g_rocks_frame_arena.high_water;
+    Rocks_LayoutStats layout = Rocks_GetLayoutStats();
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    double* allocations = calloc(frames, sizeof(double));
+    double* commands = calloc(frames, sizeof(double));
+    for (int i = 0; i < frames; i++) {
+        allocations[i] = (double)g_samples.allocations[i];
+        commands[i] = (double)g_samples.commands[i];
+    }
+
+    // Built in one buffer so the object reaches stdout in one write
+    char* json = NULL;
+    size_t json_size = 0;
+    FILE* out = open_memstream(&json, &json_size);
+    fprintf(out, "{\"name\":\"%s\",\"frames\":%d,", scene->name, frames);
+    Percentiles(out, "layout_ms", g_samples.layout, frames, 1000.0);
+    fprintf(out, ",");
+    Percentiles(out, "render_ms", g_samples.render, frames, 1000.0);
+    fprintf(out, ",");
+    Percentiles(out, "allocations_per_frame", allocations, frames, 1.0);
+    fprintf(out, ",");
+    Percentiles(out, "commands_per_frame", commands, frames, 1.0);
+    fprintf(out, ",\"peak_elements\":%d,\"peak_measured_words\":%d,\"clay_overflows\":%u",
+            layout.peak_element_count, layout.peak_text_word_count, layout.overflow_count);
+    fprintf(out, ",\"heap_setup_bytes\":%zu,\"heap_peak_bytes\":%zu,\"frame_arena_peak_bytes\":%zu,\"peak_rss_kb\":%ld}",
+            setup_heap, heap_peak, frame_arena_peak, usage.ru_maxrss);
+    fclose(out);
+
+    fwrite(json, 1, json_size, stdout);
+    fflush(stdout);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) frames = DEFAULT_FRAMES;
+    const char* only = argc > 2 ? argv[2] : NULL;
+
+    printf("{\"warmup_frames\":%d,\"scenes\":[\n", WARMUP_FRAMES);
+    fflush(stdout);
+
+    int failures = 0;
+    bool first = true;
+    for (size_t i = 0; i < sizeof(g_scenes) / sizeof(g_scenes[0]); i++) {
+        const BenchScene* scene = &g_scenes[i];
+        if (only && strcmp(only, scene->name) != 0) continue;
+
+        if (!first) printf(",\n");
+        first = false;
+        fflush(stdout);
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            _exit(RunScene(scene, frames));
+        }
+
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("{\"name\":\"%s\",\"error\":\"scene failed\"}", scene->name);
+            failures++;
+        }
+    }
+
+    printf("\n]}\n");
+    return failures > 0 ? 1 : 0;
+}
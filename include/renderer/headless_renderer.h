@@ -0,0 +1,63 @@
+#ifndef ROCKS_HEADLESS_RENDERER_H
+#define ROCKS_HEADLESS_RENDERER_H
+
+#include "rocks_clay.h"
+#include "rocks_types.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef ROCKS_USE_HEADLESS
+
+#define ROCKS_HEADLESS_MAX_FONTS 32
+#define ROCKS_HEADLESS_DEFAULT_FONT_SIZE 16
+
+// Runs the full frame loop without a window: the clock advances a fixed
+// step per frame, input comes from a script and render commands are
+// copied out instead of drawn, so results repeat exactly across runs.
+typedef struct {
+    Rocks_HeadlessConfig config;
+    Rocks* rocks;
+
+    _Atomic double time;            // Read by the layout thread when pipelined
+    uint32_t frame;
+    uint32_t next_event;
+    Clay_Vector2 wheel;             // Scrolled since the last frame
+
+    int font_sizes[ROCKS_HEADLESS_MAX_FONTS];    // 0 when the id is unused
+
+    // The last frame's commands, valid until the next frame renders
+    Clay_RenderCommand* commands;
+    int32_t command_count;
+    int32_t command_capacity;
+    uint64_t total_commands;
+} Rocks_HeadlessRenderer;
+
+bool Rocks_InitHeadless(Rocks* rocks, void* config);
+void Rocks_CleanupHeadless(Rocks* rocks);
+
+uint16_t Rocks_LoadFontHeadless(Rocks* rocks, const char* path, int size, uint16_t expected_id);
+void Rocks_UnloadFontHeadless(Rocks* rocks, uint16_t font_id);
+
+void* Rocks_LoadImageHeadless(Rocks* rocks, const char* path);
+void* Rocks_LoadImageFromMemoryHeadless(Rocks* rocks, const char* data, size_t length);
+void Rocks_UnloadImageHeadless(Rocks* rocks, void* image_data);
+Clay_Dimensions Rocks_GetImageDimensionsHeadless(Rocks* rocks, void* image_data);
+
+void Rocks_SetWindowSizeHeadless(Rocks* rocks, int width, int height);
+
+void Rocks_ProcessEventsHeadless(Rocks* rocks);
+void Rocks_RenderHeadless(Rocks* rocks, Clay_RenderCommandArray commands);
+
+double Rocks_GetTimeHeadless(Rocks* rocks);
+
+Clay_Dimensions Rocks_MeasureTextHeadless(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData);
+
+// Commands recorded from the last frame, and a hash of them that matches
+// between runs when layout output does
+Clay_RenderCommandArray Rocks_GetRecordedCommandsHeadless(Rocks* rocks);
+uint64_t Rocks_HashRecordedCommandsHeadless(Rocks* rocks);
+
+#endif // ROCKS_USE_HEADLESS
+
+#endif // ROCKS_HEADLESS_RENDERER_H
@@ -4,6 +4,14 @@
 #include "rocks_clay.h"
 #include "rocks_types.h"
 #include "rocks.h"
+#include "rocks_damage.h"
+#include "rocks_font_metrics.h"
+#include "rocks_font_registry.h"
+#include "rocks_hit_index.h"
+#include "rocks_layer.h"
+#include "rocks_scroll_physics.h"
+#include "rocks_scroll_registry.h"
+#include "renderer/raylib_shapes.h"
 #include "raylib.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,9 +21,9 @@
 #include <stdint.h>
 
 // Clay uses uppercase with underscores for constants
-#define ROCKS_MAX_SCROLL_CONTAINERS 32
 #define ROCKS_MAX_POINTER_ELEMENTS 128
 #define ROCKS_SCROLLBAR_SIZE 10.0f
+#define ROCKS_SDF_FONT_BASE_SIZE 48
 
 // Clay uses Clay_PascalCase for type definitions
 typedef enum Rocks_TouchState {
@@ -27,6 +35,17 @@ typedef enum Rocks_TouchState {
 
 typedef struct {
     Font font;
+    Rocks_AsciiMetrics ascii;
+} Rocks_RaylibFontVariant;
+
+// One font id: the shared face plus its live pixel sizes, loaded on first
+// use by a text config's fontSize. SDF fonts keep a single variant that
+// is scaled at draw time.
+typedef struct {
+    Rocks_FontFace* face;
+    int size;           // Size requested at load time, before scaling
+    bool sdf;
+    Rocks_FontVariantSet variant_set;   // Slots hold Rocks_RaylibFontVariant
 } Rocks_RaylibFont;
 
 
@@ -38,22 +57,63 @@ struct Rocks_ScrollState {
     uint32_t active_container_id; 
     Clay_Vector2 drag_start;
     Clay_Vector2 scroll_start;
-    float velocity_x;
-    float velocity_y;
 };
 
+// A cached layer's pixels, premultiplied by alpha
+typedef struct {
+    Rocks_LayerSlot slot;
+    RenderTexture2D target;
+
+    // Scroll layers shift their pixels through a second target and redraw
+    // only what changed, tracked in texture space
+    RenderTexture2D spare;
+    Rocks_DamageTracker damage;
+    Clay_Vector2 offset;            // Scroll position drawn, in whole pixels
+} Rocks_RaylibLayer;
+
+// A cached layer found this frame and where its texture goes, in pixels
+typedef struct {
+    Rocks_LayerSpan span;
+    Rocks_RaylibLayer* layer;
+    Rectangle rect;
+} Rocks_RaylibLayerDraw;
+
 struct Rocks_RaylibRenderer {
     float scale_factor;
     Rocks_RaylibFont fonts[32]; 
     Rocks* rocks;
     float scrollbar_opacity;
-    float last_mouse_move_time;
+    double last_mouse_move_time;
     
-    Rocks_ScrollContainer scroll_containers[32];
-    int scroll_container_count;
+    // Scroll containers of the last frame drawn
+    Rocks_ScrollRegistry scroll_registry;
+    Rocks_ScrollPhysics scroll_physics;
     
-    uint32_t pointer_elements[32];
-    int pointer_elements_count;
+    // Pointer and link targets of the last frame drawn
+    Rocks_HitIndex hit_index;
+
+    char* measure_buffer;
+    size_t measure_buffer_size;
+    char* draw_buffer;          // Drawing's own, as layout may measure meanwhile
+    size_t draw_buffer_size;
+
+    bool sdf_fonts;
+    Shader sdf_shader;
+
+    Rocks_RaylibShapeBatch shapes;
+
+    // Frames are drawn into the backbuffer, redrawing only damaged areas
+    Rocks_DamageTracker damage;
+    RenderTexture2D backbuffer;
+    bool backbuffer_failed;
+
+    // Elements marked as cached layers are blitted from their own targets
+    Rocks_RaylibLayer layers[ROCKS_MAX_CACHED_LAYERS];
+    Rocks_LayerTable layer_table;
+    Rocks_RaylibLayerDraw layer_draws[ROCKS_MAX_CACHED_LAYERS];
+    int layer_draw_count;
+    Clay_RenderCommand* layer_commands;
+    int32_t layer_commands_capacity;
 };
 
 
@@ -74,10 +134,12 @@ void Rocks_ToggleFullscreenRaylib(Rocks* rocks);
 
 void Rocks_HandleEventRaylib(Rocks* rocks, void* event);
 void Rocks_ProcessEventsRaylib(Rocks* rocks);
+void Rocks_SetEventWaitingRaylib(bool wait);
 
 void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands);
 
-float Rocks_GetTimeRaylib(void);
+double Rocks_GetTimeRaylib(void);
+float Rocks_GetRefreshRateRaylib(void);
 
 Clay_Dimensions Rocks_MeasureTextRaylib(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData);
 
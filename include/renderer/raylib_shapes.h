@@ -0,0 +1,58 @@
+#ifndef ROCKS_RAYLIB_SHAPES_H
+#define ROCKS_RAYLIB_SHAPES_H
+
+#include "raylib.h"
+#include "rocks_clay.h"
+#include <stdbool.h>
+
+#define ROCKS_SHAPE_BATCH_QUADS 4096
+
+// Everything the shape shader needs to draw one element. Lengths are in
+// screen pixels; a zero alpha color skips that layer.
+typedef struct {
+    Color fill;
+    Clay_CornerRadius radius;
+    Color border_color;
+    float border_top;
+    float border_right;
+    float border_bottom;
+    float border_left;
+    Color shadow_color;
+    Vector2 shadow_offset;
+    float shadow_blur;
+    float shadow_spread;
+} Rocks_ShapeStyle;
+
+typedef struct {
+    float position[2];
+    float rect[4];              // Offset from the shape center, half size
+    float radii[4];             // Top-left, top-right, bottom-right, bottom-left
+    float borders[4];           // Top, right, bottom, left
+    float shadow[4];            // Offset x/y, sigma, spread
+    unsigned char fill[4];
+    unsigned char border_color[4];
+    unsigned char shadow_color[4];
+} Rocks_ShapeVertex;
+
+// Rounded rects, borders and shadows drawn as one quad each by a signed
+// distance field shader, submitted through rlgl in as few draws as the
+// surrounding raylib calls allow. Flush before any other raylib draw or
+// scissor change so paint order is kept.
+typedef struct {
+    bool ready;
+    Shader shader;
+    int mvp_location;
+    int attrib_locations[8];
+    unsigned int vao;
+    unsigned int vbo;
+    unsigned int ebo;
+    Rocks_ShapeVertex* vertices;
+    int quad_count;
+} Rocks_RaylibShapeBatch;
+
+bool Rocks_InitShapeBatchRaylib(Rocks_RaylibShapeBatch* batch);
+void Rocks_CleanupShapeBatchRaylib(Rocks_RaylibShapeBatch* batch);
+void Rocks_FlushShapeBatchRaylib(Rocks_RaylibShapeBatch* batch);
+void Rocks_DrawShapeRaylib(Rocks_RaylibShapeBatch* batch, Rectangle rect, const Rocks_ShapeStyle* style);
+
+#endif // ROCKS_RAYLIB_SHAPES_H
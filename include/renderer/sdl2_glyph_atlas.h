@@ -0,0 +1,62 @@
+#ifndef ROCKS_SDL2_GLYPH_ATLAS_H
+#define ROCKS_SDL2_GLYPH_ATLAS_H
+
+#ifdef ROCKS_USE_SDL2
+
+#include <SDL2/SDL.h>
+#include <SDL_ttf.h>
+#include "clay.h"
+
+#define ROCKS_GLYPH_ATLAS_SIZE 1024
+#define ROCKS_GLYPH_ATLAS_PADDING 1
+
+typedef struct {
+    uint32_t codepoint;     // 0 marks an empty slot
+    SDL_Rect src;           // Location of the rendered glyph in the atlas
+    int offset_x;           // Horizontal offset of the surface from the pen position
+    int advance;
+} Rocks_SDL2Glyph;
+
+// Per-font texture holding every glyph rendered so far. Glyphs are
+// rasterized once, on first use, and packed into shelves.
+typedef struct {
+    TTF_Font* font;
+    SDL_Texture* texture;
+    int width;
+    int height;
+
+    // Shelf packer state
+    int pen_x;
+    int pen_y;
+    int shelf_height;
+
+    // Open addressing table keyed by codepoint
+    Rocks_SDL2Glyph* glyphs;
+    int glyph_capacity;
+    int glyph_count;
+
+    // Scratch geometry reused across draws
+    SDL_Vertex* vertices;
+    int* indices;
+    int vertex_capacity;
+    int vertex_count;
+} Rocks_SDL2GlyphAtlas;
+
+Rocks_SDL2GlyphAtlas* Rocks_CreateGlyphAtlasSDL2(SDL_Renderer* renderer, TTF_Font* font);
+void Rocks_DestroyGlyphAtlasSDL2(Rocks_SDL2GlyphAtlas* atlas);
+
+// Draws a UTF-8 slice as textured quads with its top-left corner at (x, y).
+// Glyph geometry is multiplied by `scale` to match the layout's bounding box.
+void Rocks_DrawTextSDL2(
+    SDL_Renderer* renderer,
+    Rocks_SDL2GlyphAtlas* atlas,
+    Clay_StringSlice text,
+    float x,
+    float y,
+    float scale,
+    SDL_Color color
+);
+
+#endif // ROCKS_USE_SDL2
+
+#endif // ROCKS_SDL2_GLYPH_ATLAS_H
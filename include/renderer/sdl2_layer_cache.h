@@ -0,0 +1,70 @@
+#ifndef ROCKS_SDL2_LAYER_CACHE_H
+#define ROCKS_SDL2_LAYER_CACHE_H
+
+#ifdef ROCKS_USE_SDL2
+
+#include <SDL2/SDL.h>
+#include "rocks_layer.h"
+
+// A cached layer's pixels, premultiplied by alpha so it composites the same
+// as drawing its commands directly
+typedef struct {
+    Rocks_LayerSlot slot;
+    SDL_Texture* texture;
+    int width;
+    int height;
+
+    // Scroll layers shift their pixels through a second texture and redraw
+    // only what changed, tracked in texture space
+    SDL_Texture* spare;
+    Rocks_DamageTracker damage;
+    Clay_Vector2 offset;            // Scroll position drawn, in whole pixels
+} Rocks_SDL2Layer;
+
+// Render targets for every element marked as a cached layer
+typedef struct {
+    Rocks_SDL2Layer entries[ROCKS_MAX_CACHED_LAYERS];
+    Rocks_LayerTable table;
+    SDL_BlendMode blend_mode;
+} Rocks_SDL2LayerCache;
+
+Rocks_SDL2LayerCache* Rocks_CreateLayerCacheSDL2(void);
+void Rocks_DestroyLayerCacheSDL2(Rocks_SDL2LayerCache* cache);
+
+void Rocks_BeginLayerCacheFrameSDL2(Rocks_SDL2LayerCache* cache);
+
+// Marks every layer for redraw, e.g. after render targets were reset
+void Rocks_InvalidateLayersSDL2(Rocks_SDL2LayerCache* cache);
+
+// Returns the layer for `id` with a texture of the given size. `stale` is
+// set when the texture must be redrawn, after which the layer's hash
+// matches `hash`. NULL when no texture is available.
+Rocks_SDL2Layer* Rocks_GetLayerSDL2(
+    Rocks_SDL2LayerCache* cache,
+    SDL_Renderer* renderer,
+    uint32_t id,
+    uint64_t hash,
+    int width,
+    int height,
+    bool* stale
+);
+
+// Returns the layer holding the content of scroll container `id`, with a
+// texture of the given size. `stale` is set when nothing in the texture can
+// be reused. NULL when no texture is available.
+Rocks_SDL2Layer* Rocks_GetScrollLayerSDL2(
+    Rocks_SDL2LayerCache* cache,
+    SDL_Renderer* renderer,
+    uint32_t id,
+    int width,
+    int height,
+    bool* stale
+);
+
+// Moves a scroll layer's pixels by whole pixels, leaving the uncovered
+// strips undefined
+bool Rocks_ShiftScrollLayerSDL2(Rocks_SDL2LayerCache* cache, SDL_Renderer* renderer, Rocks_SDL2Layer* layer, int dx, int dy);
+
+#endif // ROCKS_USE_SDL2
+
+#endif // ROCKS_SDL2_LAYER_CACHE_H
@@ -3,6 +3,9 @@
 
 
 #include "sdl2_renderer_utils.h"
+#include "sdl2_glyph_atlas.h"
+#include "sdl2_text_cache.h"
+#include "sdl2_layer_cache.h"
 
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -10,6 +13,13 @@
 #include <math.h>
 #include <string.h>
 #include "rocks_custom.h"
+#include "rocks_damage.h"
+#include "rocks_font_metrics.h"
+#include "rocks_font_registry.h"
+#include "rocks_hit_index.h"
+#include "rocks_layer.h"
+#include "rocks_scroll_physics.h"
+#include "rocks_scroll_registry.h"
 #include "rocks_types.h"
 #include "rocks_clay.h"
 
@@ -28,24 +38,76 @@ typedef enum {
 
 typedef struct {
     TTF_Font* font;
+    Rocks_SDL2GlyphAtlas* atlas;
+    Rocks_AsciiMetrics ascii;
+} Rocks_SDL2FontVariant;
+
+// One font id: the shared face plus its live pixel sizes, opened on first
+// use by a text config's fontSize (0 selects the size given at load time)
+typedef struct {
+    Rocks_FontFace* face;
+    int size;
+    Rocks_FontVariantSet variant_set;   // Slots hold Rocks_SDL2FontVariant
 } RockSDL2Font;
 
+// A cached layer found this frame and where its texture goes, in pixels
+typedef struct {
+    Rocks_LayerSpan span;
+    Rocks_SDL2Layer* layer;
+    SDL_Rect rect;
+} Rocks_SDL2LayerDraw;
+
 typedef struct {
     SDL_Window* window;
     SDL_Renderer* renderer;
     float scale_factor;
     RockSDL2Font fonts[32];
+
+    // Atlases of evicted font sizes. Eviction can happen while measuring on
+    // the layout thread, so their textures are destroyed at the next draw.
+    Rocks_SDL2GlyphAtlas** retired_atlases;
+    int retired_atlas_count;
+    int retired_atlas_capacity;
+
+    Rocks_SDL2GeometryBatch batch;
+    Rocks_SDL2ShadowCache* shadow_cache;
+    Rocks_SDL2TextCache* text_cache;
+    uint32_t text_cache_max_age;
+    char* measure_buffer;
+    size_t measure_buffer_size;
     SDL_Cursor* default_cursor;
     SDL_Cursor* pointer_cursor;
     SDL_Cursor* current_cursor;
     float scrollbar_opacity;
-    float last_mouse_move_time;
+    double last_mouse_move_time;
     SDL_Rect current_clip_rect;
     Rocks* rocks;
 
-    // Scroll container tracking
-    Rocks_ScrollContainer scroll_containers[32];
-    int scroll_container_count;
+    // Frames are drawn into the backbuffer, redrawing only damaged areas
+    Rocks_DamageTracker damage;
+    SDL_Texture* backbuffer;
+    int backbuffer_width;
+    int backbuffer_height;
+    bool backbuffer_failed;
+
+    // Elements marked as cached layers are blitted from their own targets
+    Rocks_SDL2LayerCache* layer_cache;
+    Rocks_SDL2LayerDraw layer_draws[ROCKS_MAX_CACHED_LAYERS];
+    int layer_draw_count;
+    Clay_RenderCommand* layer_commands;
+    int32_t layer_commands_capacity;
+
+    // Motion and wheel events held back by Rocks_ProcessEventsSDL2 so a
+    // burst of them reaches Clay as one; type 0 when nothing is pending
+    SDL_Event pending_motion;
+    SDL_Event pending_wheel;
+
+    // Pointer targets of the frame being drawn
+    Rocks_HitIndex hit_index;
+
+    // Scroll containers of the frame being drawn
+    Rocks_ScrollRegistry scroll_registry;
+    Rocks_ScrollPhysics scroll_physics;
     
     // Scrolling state
     TouchState current_touch_state;
@@ -53,7 +115,9 @@ typedef struct {
     Uint32 last_touch_time;
     Uint32 last_successful_click_time;
     bool had_motion_between_down_and_up;
-    Clay_ScrollContainerData* active_scroll_container;
+    Clay_ScrollContainerData* active_scroll_container;     // Points at active_scroll_data; valid while clay_generation is current
+    Clay_ScrollContainerData active_scroll_data;
+    uint32_t clay_generation;
     uint32_t active_scroll_container_id;
     bool is_scroll_thumb_dragging;
     bool is_horizontal_scroll_thumb_dragging;
@@ -70,9 +134,11 @@ void Rocks_CleanupSDL2(Rocks* rocks);
 void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands);
 uint16_t Rocks_LoadFontSDL2(Rocks* rocks, const char* path, int size, uint16_t expected_id);
 void Rocks_UnloadFontSDL2(Rocks* rocks, uint16_t font_id);
-float Rocks_GetTimeSDL2(void);
+double Rocks_GetTimeSDL2(void);
+float Rocks_GetRefreshRateSDL2(Rocks* rocks);
 void Rocks_HandleEventSDL2(Rocks* rocks, void* event);
 void Rocks_ProcessEventsSDL2(Rocks* rocks);
+bool Rocks_WaitEventsSDL2(float timeout);
 void Rocks_ToggleFullscreenSDL2(Rocks* rocks);
 void Rocks_SetWindowSizeSDL2(Rocks* rocks, int width, int height);
 
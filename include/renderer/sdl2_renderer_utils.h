@@ -6,23 +6,79 @@
 #include <SDL2/SDL.h>
 #include "clay.h"
 #include "rocks_types.h"
+#include "sdl2_shadow_cache.h"
 
 void* SDL_AllocateAligned(size_t alignment, size_t size);
 void SDL_FreeAligned(void* ptr);
 
-void DrawQuarterCircle(
-    SDL_Renderer* renderer,
-    float centerX, 
-    float centerY, 
-    float radius, 
-    float startAngle,
+// Corner quadrants, named by where the arc bulges relative to its center
+typedef enum {
+    ROCKS_CORNER_BOTTOM_RIGHT,
+    ROCKS_CORNER_BOTTOM_LEFT,
+    ROCKS_CORNER_TOP_LEFT,
+    ROCKS_CORNER_TOP_RIGHT,
+} Rocks_CornerQuadrant;
+
+// Geometry accumulated across draw calls and submitted with a single
+// SDL_RenderGeometry per texture run. Solid fills join a textured run when
+// its texture has an opaque white texel to sample, so shadows and the
+// fills drawn over them share one call. Flush before changing the clip
+// rect and before any draw that does not go through the batch, so paint
+// order is kept.
+typedef struct {
+    SDL_Renderer* renderer;
+    SDL_Texture* texture;       // Texture of the pending run, NULL for solid fills
+    bool has_solid_texel;       // Texture has an opaque white texel at solid_uv
+    SDL_FPoint solid_uv;
+    SDL_Vertex* vertices;
+    int vertex_count;
+    int vertex_capacity;
+    int* indices;
+    int index_count;
+    int index_capacity;
+} Rocks_SDL2GeometryBatch;
+
+void Rocks_FlushGeometryBatchSDL2(Rocks_SDL2GeometryBatch* batch);
+void Rocks_FreeGeometryBatchSDL2(Rocks_SDL2GeometryBatch* batch);
+
+void BatchRect(Rocks_SDL2GeometryBatch* batch, SDL_FRect rect, SDL_Color color);
+
+// Stretches a square nine-slice texture over rect. The texel at `slice`
+// is the stretchable middle and must be opaque white; solid fills sample
+// it to stay in the same run. The rest are corners and edges.
+void BatchNineSlice(
+    Rocks_SDL2GeometryBatch* batch,
+    SDL_Texture* texture,
+    SDL_FRect rect,
+    int textureSize,
+    int slice,
+    SDL_Color color
+);
+
+// Radii are in the same pixel space as rect and are clamped to fit it
+void BatchRoundedRect(
+    Rocks_SDL2GeometryBatch* batch,
+    SDL_FRect rect,
+    Clay_CornerRadius radii,
+    SDL_Color color
+);
+
+// Quarter ring in one corner; an inner radius of 0 gives a filled quarter circle
+void BatchQuarterArc(
+    Rocks_SDL2GeometryBatch* batch,
+    float centerX,
+    float centerY,
+    float outerRadius,
+    float innerRadius,
+    Rocks_CornerQuadrant quadrant,
     SDL_Color color
 );
 
 SDL_FRect ScaleBoundingBox(SDL_Renderer* renderer, float scale_factor, Clay_BoundingBox box);
 
 void RenderRoundedRectangle(
-    SDL_Renderer* renderer,
+    Rocks_SDL2GeometryBatch* batch,
+    Rocks_SDL2ShadowCache* shadows,
     SDL_FRect rect,
     Clay_CornerRadius cornerRadius,
     Clay_Color color,
@@ -35,7 +91,7 @@ void RenderRoundedRectangle(
 );
 
 void RenderBorder(
-    SDL_Renderer* renderer,
+    Rocks_SDL2GeometryBatch* batch,
     SDL_FRect rect,
     Clay_BorderElementConfig border,  // Changed from Clay_Border
     Clay_CornerRadius cornerRadius,
@@ -61,7 +117,8 @@ void RenderScrollbar(
     int mouseY,
     Clay_ScrollElementConfig *config,
     Clay_ElementId elementId,
-    float scale_factor
+    float scale_factor,
+    float opacity
 );
 
 #endif // ROCKS_USE_SDL2
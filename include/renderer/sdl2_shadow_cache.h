@@ -0,0 +1,54 @@
+#ifndef ROCKS_SDL2_SHADOW_CACHE_H
+#define ROCKS_SDL2_SHADOW_CACHE_H
+
+#ifdef ROCKS_USE_SDL2
+
+#include <SDL2/SDL.h>
+#include "clay.h"
+
+#define ROCKS_SHADOW_CACHE_SIZE 64
+
+// A blurred rounded-rect mask stored as a square nine-slice texture. The
+// `slice` pixels along each edge are corners; the texel row and column at
+// `slice` stretch to cover any element size.
+typedef struct {
+    Clay_CornerRadius radius;   // Key, in layout units
+    float blur;
+    float spread;
+    float scale;
+
+    SDL_Texture* texture;       // White, with the shadow in the alpha channel
+    int size;
+    int slice;
+    int pad;                    // Distance the blur reaches past the shape
+    uint64_t last_used_frame;
+} Rocks_SDL2Shadow;
+
+// Shadow textures shared by every element with the same corner radius,
+// blur, spread and scale. Entries used in the current frame are never
+// evicted, since the geometry batch may still reference them.
+typedef struct {
+    Rocks_SDL2Shadow entries[ROCKS_SHADOW_CACHE_SIZE];
+    int count;
+    uint64_t frame;
+} Rocks_SDL2ShadowCache;
+
+Rocks_SDL2ShadowCache* Rocks_CreateShadowCacheSDL2(void);
+void Rocks_DestroyShadowCacheSDL2(Rocks_SDL2ShadowCache* cache);
+
+void Rocks_BeginShadowCacheFrameSDL2(Rocks_SDL2ShadowCache* cache);
+
+// Returns the shadow for the key, blurring it on a miss. NULL when the
+// texture cannot be created or every slot is in use this frame.
+const Rocks_SDL2Shadow* Rocks_GetShadowSDL2(
+    Rocks_SDL2ShadowCache* cache,
+    SDL_Renderer* renderer,
+    Clay_CornerRadius radius,
+    float blur,
+    float spread,
+    float scale
+);
+
+#endif // ROCKS_USE_SDL2
+
+#endif // ROCKS_SDL2_SHADOW_CACHE_H
@@ -0,0 +1,71 @@
+#ifndef ROCKS_SDL2_TEXT_CACHE_H
+#define ROCKS_SDL2_TEXT_CACHE_H
+
+#ifdef ROCKS_USE_SDL2
+
+#include <SDL2/SDL.h>
+#include <SDL_ttf.h>
+#include "clay.h"
+
+#define ROCKS_TEXT_CACHE_DEFAULT_MAX_AGE 120
+
+typedef struct Rocks_SDL2TextCacheEntry {
+    uint64_t hash;
+    char* text;             // Null-terminated copy of the key string
+    int32_t length;
+    uint16_t font_id;
+    uint16_t font_size;
+    SDL_Color color;
+
+    SDL_Texture* texture;
+    int width;
+    int height;
+    size_t bytes;
+    uint64_t last_used_frame;
+
+    // LRU list, most recently used at the head
+    struct Rocks_SDL2TextCacheEntry* prev;
+    struct Rocks_SDL2TextCacheEntry* next;
+    struct Rocks_SDL2TextCacheEntry* bucket_next;
+} Rocks_SDL2TextCacheEntry;
+
+// Rendered text textures kept across frames, keyed by string contents,
+// font, size and color. Bounded by a byte budget and evicted least recently used.
+typedef struct {
+    Rocks_SDL2TextCacheEntry** buckets;
+    int bucket_count;
+    int entry_count;
+
+    Rocks_SDL2TextCacheEntry* lru_head;
+    Rocks_SDL2TextCacheEntry* lru_tail;
+
+    size_t bytes_used;
+    size_t byte_budget;
+    uint64_t frame;
+} Rocks_SDL2TextCache;
+
+Rocks_SDL2TextCache* Rocks_CreateTextCacheSDL2(size_t byte_budget);
+void Rocks_DestroyTextCacheSDL2(Rocks_SDL2TextCache* cache);
+
+void Rocks_BeginTextCacheFrameSDL2(Rocks_SDL2TextCache* cache);
+
+// Drops every entry not used within the last `max_age` frames
+void Rocks_EvictTextCacheSDL2(Rocks_SDL2TextCache* cache, uint64_t max_age);
+
+// Drops every entry rendered with `font_id`, e.g. when the font is unloaded
+void Rocks_InvalidateTextCacheFontSDL2(Rocks_SDL2TextCache* cache, uint16_t font_id);
+
+// Returns the cached texture for the text, rendering it on a miss
+SDL_Texture* Rocks_GetCachedTextSDL2(
+    Rocks_SDL2TextCache* cache,
+    SDL_Renderer* renderer,
+    TTF_Font* font,
+    uint16_t font_id,
+    uint16_t font_size,
+    Clay_StringSlice text,
+    SDL_Color color
+);
+
+#endif // ROCKS_USE_SDL2
+
+#endif // ROCKS_SDL2_TEXT_CACHE_H
@@ -12,6 +12,10 @@
 #include "renderer/raylib_renderer.h"
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+#include "renderer/headless_renderer.h"
+#endif
+
 
 #define DEFAULT_ARENA_SIZE (1024 * 1024 * 8)
 
@@ -57,7 +61,29 @@ void Rocks_HandleGlobalClick(Clay_ElementId elementId, Clay_PointerData pointerI
 void Rocks_HandleGlobalModalClick(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData);
 
 // Utility functions
-float Rocks_GetTime(Rocks* rocks);
+
+// Seconds on a monotonic clock, as a double so it stays sub-millisecond
+// precise through weeks of uptime
+double Rocks_GetTime(Rocks* rocks);
+
+// Frame scheduling for Rocks_Config.idle_mode. Anything that changes over
+// time without input (animations, inertia, a blinking cursor) asks for the
+// frames it needs; otherwise the loop sleeps until the next event.
+void Rocks_RequestFrame(void);
+void Rocks_RequestFrameIn(float seconds);
+
+// Capacity use since Rocks_Init. Clay restarting under auto_grow_arena
+// bumps the generation, which invalidates any Clay pointers held on to.
+Rocks_LayoutStats Rocks_GetLayoutStats(void);
+uint32_t Rocks_GetClayGeneration(void);
+
+// Counts laid out frames. Renderers use it to tell what the frames being
+// laid out and drawn still need.
+uint64_t Rocks_GetFrameIndex(void);
+
+// Scroll state for drawing: while a pipelined frame is drawn, this is the
+// state it was laid out with rather than Clay's current one
+Clay_ScrollContainerData Rocks_GetScrollContainerData(Clay_ElementId id);
 
 // Renderer-specific functions
 #ifdef ROCKS_USE_SDL2
@@ -68,4 +94,8 @@ SDL_Renderer* Rocks_GetRenderer(void);
 Rocks_RaylibRenderer* Rocks_GetRaylibRenderer(void);
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+Rocks_HeadlessRenderer* Rocks_GetHeadlessRenderer(void);
+#endif
+
 #endif // Rocks_H
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef ROCKS_ARENA_H
+#define ROCKS_ARENA_H
+
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define ROCKS_FRAME_ARENA_BLOCK_SIZE (1024 * 1024)
+
+typedef struct Rocks_ArenaBlock {
+    struct Rocks_ArenaBlock* next;
+    size_t size;                // Usable bytes after the header
+    size_t offset;
+} Rocks_ArenaBlock;
+
+// Bump allocator for data that lives until the end of a frame. Blocks are
+// chained as a frame outgrows them and kept for the frames after it, so
+// once the largest frame has been seen nothing is allocated.
+typedef struct {
+    Rocks_ArenaBlock* first;
+    Rocks_ArenaBlock* current;
+    size_t block_size;          // Size of the first block; later ones double
+    size_t used;                // Bytes handed out this frame, padding included
+    size_t capacity;            // Across all blocks
+    size_t high_water;          // Most any one frame has used
+    uint32_t block_count;
+    uint32_t overflows;         // Allocations that failed since init
+} Rocks_FrameArena;
+
+extern Rocks_FrameArena g_rocks_frame_arena;
+
+bool Rocks_InitFrameArena(Rocks_FrameArena* arena, size_t block_size);
+void Rocks_FreeFrameArena(Rocks_FrameArena* arena);
+
+// Invalidates everything allocated from `arena` and keeps its blocks
+void Rocks_ResetFrameArena(Rocks_FrameArena* arena);
+
+// `align` must be a power of two; 0 picks the strictest fundamental one.
+// Returns NULL, after printing why, when a new block cannot be allocated.
+void* Rocks_ArenaAlloc(Rocks_FrameArena* arena, size_t size, size_t align);
+
+// Allocates from the frame being laid out. The memory stays valid until
+// that frame has been drawn.
+void* Rocks_FrameAlloc(size_t size, size_t align);
+#define ROCKS_FRAME_NEW(type) ((type*)Rocks_FrameAlloc(sizeof(type), alignof(type)))
+
+// Selects the arena Rocks_FrameAlloc draws from; NULL goes back to
+// g_rocks_frame_arena
+void Rocks_SetFrameArena(Rocks_FrameArena* arena);
+Rocks_FrameArena* Rocks_GetFrameArena(void);
+
+#endif // ROCKS_ARENA_H
@@ -8,4 +8,22 @@
 
 #include "clay.h"
 
+// Layout elements and measured words held by the current Clay context.
+// Clay keeps the counts private, so they are read from the translation
+// unit that holds its implementation.
+int32_t Rocks_GetClayElementCount(void);
+int32_t Rocks_GetClayMeasuredWordCount(void);
+
+#ifdef ROCKS_CLAY_IMPLEMENTATION
+int32_t Rocks_GetClayElementCount(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context ? context->layoutElements.length : 0;
+}
+
+int32_t Rocks_GetClayMeasuredWordCount(void) {
+    Clay_Context* context = Clay_GetCurrentContext();
+    return context ? context->measuredWords.length - context->measuredWordsFreeList.length : 0;
+}
+#endif
+
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef ROCKS_CUSTOM_H
 #define ROCKS_CUSTOM_H
 
+#include "rocks_arena.h"
 #include "rocks_clay.h"
 
 typedef struct {
@@ -11,17 +12,14 @@ typedef struct {
     float shadowBlurRadius;
     float shadowSpread;
     const char* link; 
+    // Render this element's subtree once and reuse it until it changes. The
+    // element must draw something ahead of its children, such as a
+    // background color, a clip or an image; a transparent element that only
+    // lays out its children emits no command to start the layer from.
+    bool cachedLayer;
 } RocksCustomData;
 
-// Arena allocator for custom data
-typedef struct {
-    void* memory;
-    uintptr_t offset;
-} RocksArena;
-
-extern RocksArena g_rocks_frame_arena;
-
-// Function to allocate custom data
+// Copies `data` into the frame arena, so it lives as long as the frame
 RocksCustomData* Rocks_AllocateCustomData(RocksCustomData data);
 
 #endif // ROCKS_CUSTOM_H
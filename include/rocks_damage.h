@@ -0,0 +1,72 @@
+#ifndef ROCKS_DAMAGE_H
+#define ROCKS_DAMAGE_H
+
+#include "rocks_clay.h"
+
+#define ROCKS_MAX_DAMAGE_RECTS 8
+#define ROCKS_MAX_DAMAGE_CLIP_DEPTH 16
+#define ROCKS_DAMAGE_HASH_SEED 14695981039346656037ULL
+
+// Renderer state that changes how a command draws without appearing in its
+// render data, such as scrollbar hover or fade. Mixed into the content hash.
+typedef uint64_t (*Rocks_DamageHashFunction)(const Clay_RenderCommand* command, void* userData);
+
+typedef struct {
+    uint64_t hash;
+    Clay_BoundingBox bounds;    // Painted area inside the active clip
+    uint32_t id;
+    uint8_t type;
+    bool matched;
+} Rocks_DamageRecord;
+
+// Compares each frame's render commands with the previous frame's by id,
+// bounds and content hash, and collects the areas that changed in layout
+// units. Renderers redraw only those areas into a persistent backbuffer.
+// A zero-initialized tracker reports a full redraw on its first frame.
+typedef struct {
+    Rocks_DamageRecord* records;    // Previous frame, in paint order
+    Rocks_DamageRecord* scratch;
+    uint32_t record_count;
+    uint32_t record_capacity;
+    int32_t* index;                 // Open addressing table into records
+    uint32_t index_capacity;
+
+    Rocks_DamageHashFunction extra_hash;
+    void* user_data;
+
+    Clay_Dimensions viewport;
+    bool invalid;                   // Set by Rocks_InvalidateDamage
+    Clay_Vector2 shift;             // Set by Rocks_ShiftDamage
+
+    bool full;                      // This frame redraws everything
+    Clay_BoundingBox rects[ROCKS_MAX_DAMAGE_RECTS];
+    int rect_count;
+} Rocks_DamageTracker;
+
+void Rocks_FreeDamageTracker(Rocks_DamageTracker* tracker);
+
+// Forces a full redraw next frame, e.g. after the backbuffer is recreated
+// or a font is replaced under the same id
+void Rocks_InvalidateDamage(Rocks_DamageTracker* tracker);
+
+// Moves what the previous frame painted by `offset`, for a target whose
+// pixels were scrolled in place. The edges this uncovers are damaged by the
+// next Rocks_ComputeDamage.
+void Rocks_ShiftDamage(Rocks_DamageTracker* tracker, Clay_Vector2 offset);
+
+void Rocks_ComputeDamage(Rocks_DamageTracker* tracker, Clay_RenderCommandArray commands, Clay_Dimensions viewport);
+void Rocks_AddDamage(Rocks_DamageTracker* tracker, Clay_BoundingBox rect);
+
+// Area a command may paint, including shadows and anti-aliasing fringes
+Clay_BoundingBox Rocks_GetCommandDamageBounds(const Clay_RenderCommand* command);
+bool Rocks_DamageOverlaps(Clay_BoundingBox a, Clay_BoundingBox b);
+
+// Overlap of two boxes, all zero when they do not overlap
+Clay_BoundingBox Rocks_IntersectBox(Clay_BoundingBox a, Clay_BoundingBox b);
+
+uint64_t Rocks_DamageHash(uint64_t hash, const void* data, size_t size);
+
+// Hash of what a command draws, leaving out where it draws it
+uint64_t Rocks_HashRenderCommand(const Clay_RenderCommand* command);
+
+#endif // ROCKS_DAMAGE_H
@@ -0,0 +1,35 @@
+#ifndef ROCKS_FONT_METRICS_H
+#define ROCKS_FONT_METRICS_H
+
+#include "rocks_clay.h"
+
+#define ROCKS_ASCII_FIRST 32
+#define ROCKS_ASCII_LAST 126
+#define ROCKS_ASCII_COUNT (ROCKS_ASCII_LAST - ROCKS_ASCII_FIRST + 1)
+
+// Precomputed metrics for printable ASCII, filled by the backend when a
+// font is loaded. Measuring pure-ASCII text then needs no font calls.
+typedef struct {
+    bool valid;
+    float line_height;
+    float advances[128];
+    float min_x[128];           // Left bearing of the glyph box
+    float max_x[128];           // Right edge of the glyph box
+    int16_t* kerning;           // ROCKS_ASCII_COUNT^2 pairs, NULL when the font has none
+} Rocks_AsciiMetrics;
+
+// True when every byte is printable ASCII (32..126)
+bool Rocks_IsPrintableAscii(Clay_StringSlice text);
+
+// Width of a printable ASCII slice in the metrics' pixel units
+float Rocks_MeasureAsciiWidth(const Rocks_AsciiMetrics* metrics, Clay_StringSlice text);
+
+void Rocks_FreeAsciiMetrics(Rocks_AsciiMetrics* metrics);
+
+// Layout units per pixel of a loaded font variant. Bitmap variants are
+// rasterized at font_size * scale_factor pixels, SDF variants at their own
+// base size and drawn at font_size; measuring through either gives the
+// same layout size.
+float Rocks_FontLayoutRatio(bool sdf, float font_size, float base_size, float scale_factor);
+
+#endif // ROCKS_FONT_METRICS_H
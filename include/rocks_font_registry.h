@@ -0,0 +1,50 @@
+#ifndef ROCKS_FONT_REGISTRY_H
+#define ROCKS_FONT_REGISTRY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Pixel sizes kept per font id before sizes that have gone unused are
+// dropped. Sizes in use are never dropped, so an id can hold more.
+#define ROCKS_FONT_VARIANT_SOFT_LIMIT 8
+
+// Font file contents, loaded once per path and shared by every font id
+// and size variant created from it.
+typedef struct Rocks_FontFace {
+    char* path;
+    unsigned char* data;
+    size_t size;
+    int ref_count;
+    struct Rocks_FontFace* next;
+} Rocks_FontFace;
+
+typedef struct {
+    int size;               // 0 marks an empty slot
+    uint64_t last_frame;    // Rocks_GetFrameIndex when the size was last asked for
+    void* variant;          // Backend object, allocated and freed by the backend
+} Rocks_FontVariantSlot;
+
+// The size variants of one font id. Slots may move as the set grows, the
+// variants they point at do not.
+typedef struct {
+    Rocks_FontVariantSlot* slots;
+    int count;
+    int capacity;
+} Rocks_FontVariantSet;
+
+Rocks_FontFace* Rocks_AcquireFontFace(const char* path);
+void Rocks_ReleaseFontFace(Rocks_FontFace* face);
+
+// Returns the slot for `size` in `frame`, or -1 when the set cannot grow.
+// When *needs_load is set, the caller must release whatever the slot's
+// variant holds (allocating it when NULL), instantiate the size, then
+// record the outcome with Rocks_SetFontVariant. Sizes used in `frame` or
+// the one before it, which may still be drawing, are never replaced.
+int Rocks_AcquireFontVariant(Rocks_FontVariantSet* set, int size, uint64_t frame, bool* needs_load);
+void Rocks_SetFontVariant(Rocks_FontVariantSet* set, int slot, int size);
+
+// Frees the slots; the backend frees their variants first
+void Rocks_FreeFontVariantSet(Rocks_FontVariantSet* set);
+
+#endif // ROCKS_FONT_REGISTRY_H
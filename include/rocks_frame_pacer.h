@@ -0,0 +1,38 @@
+#ifndef ROCKS_FRAME_PACER_H
+#define ROCKS_FRAME_PACER_H
+
+#include "rocks_types.h"
+
+#define ROCKS_FRAME_PACER_DEFAULT_FPS 60.0f
+#define ROCKS_FRAME_PACER_MAX_DIVISOR 4
+
+// Time left to the deadline below which the pacer spins instead of asking
+// the OS to sleep, since sleeps overshoot by up to a scheduler tick
+#define ROCKS_FRAME_PACER_SPIN_MARGIN 0.002
+
+// Spaces out frames for Rocks_Config.frame_pacing. Deadlines advance by a
+// fixed interval rather than from the end of each frame, so timing noise
+// does not accumulate into drift.
+typedef struct {
+    Rocks_FramePacing mode;
+    double interval;            // Seconds per frame at the base rate
+    double next_deadline;       // 0 until the first frame ends
+    double frame_start;
+    double work_average;        // Smoothed time spent producing a frame
+    int divisor;                // Adaptive pacing runs at 1 / divisor of the base rate
+} Rocks_FramePacer;
+
+// `refresh_rate` is the display's, or 0 when unknown; it stands in for a
+// target_fps of 0
+void Rocks_InitFramePacer(Rocks_FramePacer* pacer, Rocks_FramePacing mode, float target_fps, float refresh_rate);
+
+void Rocks_BeginPacedFrame(Rocks_FramePacer* pacer, double now);
+
+// Blocks until the next frame is due: sleeps while the deadline is far off,
+// then spins on the clock for the last stretch
+void Rocks_EndPacedFrame(Rocks_FramePacer* pacer);
+
+// Sleeps for roughly `seconds`, possibly less
+void Rocks_SleepSeconds(double seconds);
+
+#endif // ROCKS_FRAME_PACER_H
@@ -0,0 +1,52 @@
+#ifndef ROCKS_HIT_INDEX_H
+#define ROCKS_HIT_INDEX_H
+
+#include "rocks_clay.h"
+#include "rocks_custom.h"
+
+#define ROCKS_MAX_HIT_CLIP_DEPTH 16
+#define ROCKS_HIT_GRID_MIN_CELL 32.0f
+#define ROCKS_HIT_GRID_MAX_CELLS 64     // Per axis
+
+// What a command's custom data makes it respond to
+typedef enum {
+    ROCKS_HIT_CURSOR_POINTER = 1 << 0,
+    ROCKS_HIT_LINK = 1 << 1
+} Rocks_HitFlags;
+
+typedef struct {
+    Clay_BoundingBox bounds;    // Visible part, inside every enclosing clip
+    const RocksCustomData* data;
+    uint32_t id;
+    uint32_t flags;
+} Rocks_HitEntry;
+
+// Uniform grid over one frame's interactive commands, so pointer queries
+// look at the few entries in one cell instead of every command. Entries
+// stay in paint order, which is Clay's z-order, and each cell lists its
+// entries in that order too.
+typedef struct {
+    Rocks_HitEntry* entries;
+    int32_t entry_count;
+    int32_t entry_capacity;
+
+    int32_t* cell_start;        // Offsets into cell_entries, one per cell plus one
+    int32_t* cell_entries;
+    int32_t cell_entry_capacity;
+    int32_t cell_capacity;
+
+    int columns;
+    int rows;
+    float cell_width;
+    float cell_height;
+} Rocks_HitIndex;
+
+void Rocks_FreeHitIndex(Rocks_HitIndex* index);
+
+// Rebuilds the index from `commands`, laid out for `viewport`
+void Rocks_BuildHitIndex(Rocks_HitIndex* index, Clay_RenderCommandArray commands, Clay_Dimensions viewport);
+
+// Topmost entry under the point with any of `flags`, or NULL
+const Rocks_HitEntry* Rocks_HitTest(const Rocks_HitIndex* index, float x, float y, uint32_t flags);
+
+#endif // ROCKS_HIT_INDEX_H
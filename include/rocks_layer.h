@@ -0,0 +1,81 @@
+#ifndef ROCKS_LAYER_H
+#define ROCKS_LAYER_H
+
+#include "rocks_clay.h"
+#include "rocks_damage.h"
+
+#define ROCKS_MAX_CACHED_LAYERS 32
+
+// Frames a layer's texture is kept after its element was last drawn
+#define ROCKS_LAYER_MAX_AGE 600
+
+// The run of render commands drawn by an element marked with
+// RocksCustomData.cachedLayer: its first command of any type and every
+// command after it that stays inside its bounds, up to the end of any clip
+// it opens.
+typedef struct {
+    int32_t first;              // Index of the element's first command
+    int32_t count;              // Commands in the layer, including the first
+    uint32_t id;
+    uint64_t hash;              // Content hash, positions relative to bounds
+    Clay_BoundingBox bounds;    // Painted area, including the root's shadow
+} Rocks_LayerSpan;
+
+// Fills `span` when the command at `index` starts a cached layer. The extra
+// hash folds in renderer state the commands do not carry, as for damage.
+bool Rocks_FindLayerSpan(
+    Clay_RenderCommandArray* commands,
+    int32_t index,
+    Rocks_DamageHashFunction extra_hash,
+    void* userData,
+    Rocks_LayerSpan* span
+);
+
+// Fills `span` with the scrolled content of a scroll container when the
+// command at `index` opens its clip: everything up to the matching
+// SCISSOR_END apart from the container's own background and border. The
+// bounds are the clip area and the hash is unused.
+bool Rocks_FindScrollSpan(Clay_RenderCommandArray* commands, int32_t index, Rocks_LayerSpan* span);
+
+// What every renderer's layer entry starts with
+typedef struct {
+    uint32_t id;
+    uint64_t hash;
+    bool scrolls;               // Holds a scroll container's content
+    bool dirty;                 // Must be redrawn in full
+    uint64_t last_used_frame;
+} Rocks_LayerSlot;
+
+typedef void (*Rocks_LayerReleaseFunction)(void* entry);
+
+// A renderer's layer entries, each `entry_size` bytes and starting with a
+// Rocks_LayerSlot. Entries used in the current frame are never evicted;
+// the rest go once they have been unused for ROCKS_LAYER_MAX_AGE frames or
+// their slot is needed.
+typedef struct {
+    void* entries;              // ROCKS_MAX_CACHED_LAYERS of them
+    size_t entry_size;
+    int count;
+    uint64_t frame;
+    Rocks_LayerReleaseFunction release;
+} Rocks_LayerTable;
+
+void Rocks_InitLayerTable(Rocks_LayerTable* table, void* entries, size_t entry_size, Rocks_LayerReleaseFunction release);
+void Rocks_ClearLayerTable(Rocks_LayerTable* table);
+
+// Ages the entries, releasing those that have gone unused too long
+void Rocks_BeginLayerTableFrame(Rocks_LayerTable* table);
+
+// Marks every entry for redraw, e.g. after render targets were lost
+void Rocks_InvalidateLayerTable(Rocks_LayerTable* table);
+
+// Finds the entry for `id`, or releases the least recently used one to
+// make room and returns it zeroed and dirty. NULL when every entry is in
+// use this frame.
+void* Rocks_AcquireLayerEntry(Rocks_LayerTable* table, uint32_t id, bool scrolls);
+
+// Whether the entry must be redrawn in full, because it is dirty or its
+// content hash differs from `hash`. Clears the flag and keeps the hash.
+bool Rocks_TakeLayerStale(Rocks_LayerSlot* slot, uint64_t hash);
+
+#endif // ROCKS_LAYER_H
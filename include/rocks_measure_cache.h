@@ -0,0 +1,51 @@
+#ifndef ROCKS_MEASURE_CACHE_H
+#define ROCKS_MEASURE_CACHE_H
+
+#include "rocks_clay.h"
+
+#define ROCKS_MEASURE_CACHE_CAPACITY 4096
+#define ROCKS_MEASURE_CACHE_MAX_AGE 120
+
+typedef Clay_Dimensions (*Rocks_MeasureTextFunction)(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData);
+
+typedef struct {
+    uint64_t hash;              // 0 marks an empty slot
+    uint32_t last_used_frame;
+    int32_t length;
+    uint16_t font_id;
+    uint16_t font_size;
+    Clay_Dimensions dimensions;
+} Rocks_MeasureCacheEntry;
+
+// Open addressing cache of text measurements shared by every backend.
+// Entries not used for `max_age` frames are dropped when the table is
+// compacted at the start of a frame.
+typedef struct {
+    Rocks_MeasureCacheEntry* entries;
+    Rocks_MeasureCacheEntry* scratch;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t frame;
+    uint32_t max_age;
+
+    Rocks_MeasureTextFunction measure;
+    void* user_data;
+
+    uint64_t hits;
+    uint64_t misses;
+} Rocks_MeasureCache;
+
+extern Rocks_MeasureCache g_rocks_measure_cache;
+
+bool Rocks_InitMeasureCache(uint32_t capacity);
+void Rocks_CleanupMeasureCache(void);
+
+// Backends register their measure function here instead of with Clay
+void Rocks_SetMeasureTextFunction(Rocks_MeasureTextFunction measure, void* userData);
+
+void Rocks_BeginMeasureCacheFrame(void);
+
+// Call with the font lock held while a layout worker may be measuring
+void Rocks_ClearMeasureCache(void);
+
+#endif // ROCKS_MEASURE_CACHE_H
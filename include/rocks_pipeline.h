@@ -0,0 +1,61 @@
+#ifndef ROCKS_PIPELINE_H
+#define ROCKS_PIPELINE_H
+
+#include "rocks_arena.h"
+#include "rocks_clay.h"
+#include "rocks_types.h"
+
+// Scroll state as it was when a frame was laid out. `data.scrollPosition`
+// points at `position`.
+typedef struct {
+    uint32_t id;
+    Clay_ScrollContainerData data;
+    Clay_Vector2 position;
+} Rocks_ScrollSnapshot;
+
+// One laid out frame, copied out of Clay so it stays valid while the next
+// frame is laid out: the commands, the text they point at, the scroll
+// state and theme drawing looks up, and the arena their custom data lives in
+typedef struct {
+    Clay_RenderCommand* commands;
+    int32_t command_count;
+    int32_t command_capacity;
+
+    char* text;
+    size_t text_capacity;
+
+    Rocks_ScrollSnapshot* scrolls;
+    int32_t scroll_count;
+    int32_t scroll_capacity;
+
+    Rocks_Theme theme;
+    Rocks_FrameArena arena;
+} Rocks_PipelineFrame;
+
+typedef void (*Rocks_PipelineJob)(void* userData);
+
+bool Rocks_InitPipelineFrame(Rocks_PipelineFrame* frame, size_t arena_size);
+void Rocks_FreePipelineFrame(Rocks_PipelineFrame* frame);
+
+// Copies `commands` and everything they reference into `frame`. Must run on
+// the thread that laid them out, before the next layout begins.
+bool Rocks_CaptureFrame(Rocks_PipelineFrame* frame, Clay_RenderCommandArray commands);
+Clay_RenderCommandArray Rocks_GetFrameCommands(Rocks_PipelineFrame* frame);
+
+// While a captured frame is being drawn, scroll and theme lookups made from
+// the drawing thread read it instead of the live state; NULL goes back
+void Rocks_SetDrawnFrame(const Rocks_PipelineFrame* frame);
+const Rocks_PipelineFrame* Rocks_GetDrawnFrame(void);
+
+// Runs `job` on a worker thread each time it is kicked
+bool Rocks_StartPipeline(Rocks_PipelineJob job, void* userData);
+void Rocks_KickPipeline(void);
+void Rocks_WaitPipeline(void);
+void Rocks_StopPipeline(void);
+
+// Serializes text measurement with font use while drawing, which may then
+// happen on different threads
+void Rocks_LockFonts(void);
+void Rocks_UnlockFonts(void);
+
+#endif // ROCKS_PIPELINE_H
@@ -0,0 +1,43 @@
+#ifndef ROCKS_PROFILE_H
+#define ROCKS_PROFILE_H
+
+// Frame profiler. Build with ROCKS_PROFILE defined (make PROFILE=1) to
+// record timed zones into a ring buffer and write them out as Chrome trace
+// JSON, which chrome://tracing and ui.perfetto.dev open. Without it every
+// macro below compiles to nothing.
+//
+//     ROCKS_PROFILE_BEGIN(layout);
+//     ...
+//     ROCKS_PROFILE_END(layout);
+//
+// Zones are named by an identifier so the start time can live in a local;
+// a begin and its end must sit in the same block.
+
+#include <stdbool.h>
+
+#define ROCKS_PROFILE_RING_SIZE 65536   // Events kept; must be a power of two
+
+#ifdef ROCKS_PROFILE
+
+void Rocks_ProfileRecord(const char* name, double start, double end);
+double Rocks_ProfileNow(void);
+
+// Writes every event still in the ring to `path`. Returns false when the
+// file cannot be written.
+bool Rocks_ProfileDump(const char* path);
+void Rocks_ProfileReset(void);
+
+#define ROCKS_PROFILE_BEGIN(zone) double rocks_profile_##zone = Rocks_ProfileNow()
+#define ROCKS_PROFILE_END(zone) Rocks_ProfileRecord(#zone, rocks_profile_##zone, Rocks_ProfileNow())
+
+#else
+
+#define ROCKS_PROFILE_BEGIN(zone) do {} while (0)
+#define ROCKS_PROFILE_END(zone) do {} while (0)
+
+static inline bool Rocks_ProfileDump(const char* path) { (void)path; return false; }
+static inline void Rocks_ProfileReset(void) {}
+
+#endif // ROCKS_PROFILE
+
+#endif // ROCKS_PROFILE_H
@@ -0,0 +1,49 @@
+#ifndef ROCKS_SCROLL_PHYSICS_H
+#define ROCKS_SCROLL_PHYSICS_H
+
+#include "rocks_clay.h"
+
+// Velocity falls by a factor of e every 1 / ROCKS_SCROLL_FRICTION seconds
+#define ROCKS_SCROLL_FRICTION 4.0f
+#define ROCKS_SCROLL_STOP_SPEED 20.0f       // Layout units per second
+#define ROCKS_SCROLL_MAX_SPEED 8000.0f
+// A drag that rested longer than this before release does not fling
+#define ROCKS_SCROLL_RELEASE_WINDOW 0.1
+
+typedef struct {
+    uint32_t id;
+    Clay_Vector2 velocity;      // Layout units per second
+    double last_drag_time;
+    bool held;                  // Following a pointer; coasts once released
+} Rocks_ScrollBody;
+
+// Momentum of the scroll containers that are being dragged or coasting.
+// Only those have a body, so there are rarely more than one or two.
+typedef struct {
+    Rocks_ScrollBody* bodies;
+    int32_t count;
+    int32_t capacity;
+    double last_step_time;
+} Rocks_ScrollPhysics;
+
+void Rocks_FreeScrollPhysics(Rocks_ScrollPhysics* physics);
+
+// Keeps the content covering the container
+void Rocks_ClampScrollPosition(Clay_ScrollContainerData* data);
+
+// Moves the content by `delta` at once, as a wheel does, cancelling any
+// coasting the container was doing
+void Rocks_ScrollBy(Rocks_ScrollPhysics* physics, uint32_t id, Clay_ScrollContainerData* data, Clay_Vector2 delta);
+
+// Moves the content with a pointer that moved by `delta` at `time` (in
+// seconds), keeping track of how fast it goes
+void Rocks_DragScroll(Rocks_ScrollPhysics* physics, uint32_t id, Clay_ScrollContainerData* data, Clay_Vector2 delta, double time);
+// Lets a dragged container coast on from the speed it was released at
+void Rocks_ReleaseScroll(Rocks_ScrollPhysics* physics, uint32_t id, double time);
+void Rocks_StopScroll(Rocks_ScrollPhysics* physics, uint32_t id);
+
+// Advances coasting containers to `time`. Returns true while any of them
+// is still moving, so the caller knows to ask for another frame.
+bool Rocks_StepScrollPhysics(Rocks_ScrollPhysics* physics, double time);
+
+#endif // ROCKS_SCROLL_PHYSICS_H
@@ -0,0 +1,41 @@
+#ifndef ROCKS_SCROLL_REGISTRY_H
+#define ROCKS_SCROLL_REGISTRY_H
+
+#include "rocks_clay.h"
+
+typedef struct {
+    uint32_t id;
+    int32_t parent;             // Index of the enclosing container, -1 at the top
+    Clay_BoundingBox bounds;    // As laid out
+    Clay_BoundingBox visible;   // Inside the viewport and every enclosing container
+} Rocks_ScrollEntry;
+
+// The scroll containers of one frame, found from its scissor commands.
+// Entries are in paint order, so a container comes after the ones it is
+// nested in and after anything it is drawn over.
+typedef struct {
+    Rocks_ScrollEntry* entries;
+    int32_t count;
+    int32_t capacity;
+
+    int32_t* index;             // Open addressing table of entry indices by id, -1 when empty
+    uint32_t index_capacity;
+} Rocks_ScrollRegistry;
+
+void Rocks_FreeScrollRegistry(Rocks_ScrollRegistry* registry);
+
+void Rocks_BuildScrollRegistry(Rocks_ScrollRegistry* registry, Clay_RenderCommandArray commands, Clay_Dimensions viewport);
+
+const Rocks_ScrollEntry* Rocks_FindScrollEntry(const Rocks_ScrollRegistry* registry, uint32_t id);
+
+// Innermost, topmost container showing the point, or NULL
+const Rocks_ScrollEntry* Rocks_ScrollEntryAt(const Rocks_ScrollRegistry* registry, float x, float y);
+
+// The container `entry` is nested in, or NULL. A wheel walks out along
+// these until it finds a container that can still move.
+const Rocks_ScrollEntry* Rocks_GetScrollParent(const Rocks_ScrollRegistry* registry, const Rocks_ScrollEntry* entry);
+
+// Whether moving the content by `delta` would change its position
+bool Rocks_CanScrollBy(const Clay_ScrollContainerData* data, Clay_Vector2 delta);
+
+#endif // ROCKS_SCROLL_REGISTRY_H
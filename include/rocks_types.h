@@ -9,11 +9,6 @@ typedef struct Rocks_RaylibRenderer Rocks_RaylibRenderer;
 typedef struct Rocks_ScrollState Rocks_ScrollState;
 
 
-typedef struct Rocks_ScrollContainer {
-    uint32_t elementId;
-    bool openThisFrame;
-} Rocks_ScrollContainer;
-
 typedef struct {
     bool is_open;
     float width;
@@ -65,6 +60,13 @@ typedef struct {
     void* extension;
 } Rocks_Theme;
 
+typedef enum {
+    ROCKS_FRAME_PACING_FIXED,       // Wait out target_fps between frames
+    ROCKS_FRAME_PACING_VSYNC,       // Let the display's vertical sync set the pace
+    ROCKS_FRAME_PACING_UNCAPPED,    // Draw frames back to back
+    ROCKS_FRAME_PACING_ADAPTIVE     // Fixed, dropping to a whole fraction of the rate while frames run long
+} Rocks_FramePacing;
+
 typedef struct {
     uint32_t window_width;
     uint32_t window_height;
@@ -72,9 +74,37 @@ typedef struct {
     float scale_factor;
     Rocks_Theme theme;
     void* renderer_config;
-    size_t arena_size;
+    size_t arena_size;          // Bytes for Clay; 0 sizes it to exactly what Clay needs
+    int32_t max_element_count;  // Clay's element capacity; 0 keeps Clay's default
+    int32_t max_text_word_count;    // Measured words Clay caches; 0 keeps Clay's default
+
+    // When a frame runs out of Clay capacity, restart Clay with twice the
+    // capacity and lay the frame out again. Scroll positions start over.
+    bool auto_grow_arena;
+    size_t max_arena_size;      // Limit for auto_grow_arena; 0 for none
+    bool idle_mode;             // Sleep until input or Rocks_RequestFrame instead of redrawing every frame
+    Rocks_FramePacing frame_pacing;
+    float target_fps;           // Rate for fixed and adaptive pacing; 0 follows the display
+
+    // Lay out the next frame on a worker thread while this one draws. The
+    // update function then runs off the main thread, so it must not load
+    // fonts or images or resize the window, and input shows up one frame
+    // later.
+    // Ignored by the raylib backend.
+    bool pipelined;
 } Rocks_Config;
 
+// How much of Clay's capacity layouts have needed
+typedef struct {
+    size_t arena_size;
+    int32_t max_element_count;
+    int32_t max_text_word_count;
+    int32_t peak_element_count;
+    int32_t peak_text_word_count;
+    uint32_t overflow_count;    // Layouts that ran out of capacity
+    uint32_t grow_count;        // Times Clay was restarted larger
+} Rocks_LayoutStats;
+
 #ifdef ROCKS_USE_SDL2
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
@@ -85,6 +115,8 @@ typedef struct {
     float scale_factor;
     bool vsync;
     bool high_dpi;
+    size_t text_cache_budget;       // Bytes of cached text textures; 0 draws text from the glyph atlas
+    uint32_t text_cache_max_age;    // Frames an unused text texture survives; 0 uses the default
 } Rocks_ConfigSDL2;
 
 struct Rocks {
@@ -106,6 +138,7 @@ typedef struct {
     float scale_factor;
     bool vsync;
     bool high_dpi;
+    bool sdf_fonts;     // Build fonts as signed distance fields and honor fontSize
 } Rocks_RaylibConfig;
 
 struct Rocks {
@@ -119,6 +152,57 @@ struct Rocks {
     RenderTexture2D target;
 };
 
-#endif // ROCKS_USE_RAYLIB
+#elif defined(ROCKS_USE_HEADLESS)
+
+typedef enum {
+    ROCKS_HEADLESS_EVENT_MOUSE_MOVE,    // Pointer to x, y
+    ROCKS_HEADLESS_EVENT_MOUSE_DOWN,
+    ROCKS_HEADLESS_EVENT_MOUSE_UP,
+    ROCKS_HEADLESS_EVENT_WHEEL,         // Scroll by x, y
+    ROCKS_HEADLESS_EVENT_TEXT,          // Type the character in code
+    ROCKS_HEADLESS_EVENT_KEY_ENTER,
+    ROCKS_HEADLESS_EVENT_KEY_BACKSPACE,
+    ROCKS_HEADLESS_EVENT_KEY_LEFT,
+    ROCKS_HEADLESS_EVENT_KEY_RIGHT,
+    ROCKS_HEADLESS_EVENT_RESIZE,        // Window to x by y
+    ROCKS_HEADLESS_EVENT_QUIT
+} Rocks_HeadlessEventType;
+
+// Input delivered at the start of frame `frame`, counting from 0. Scripts
+// are sorted by frame; events sharing a frame apply in order.
+typedef struct {
+    uint32_t frame;
+    Rocks_HeadlessEventType type;
+    float x;
+    float y;
+    int code;
+} Rocks_HeadlessEvent;
+
+typedef void (*Rocks_HeadlessFrameFunction)(Clay_RenderCommandArray commands, uint32_t frame, void* userData);
+
+typedef struct {
+    double frame_time;              // Seconds the clock advances per frame; 0 uses 1/60
+    uint32_t max_frames;            // Rocks_Run returns after this many frames; 0 runs until quit
+    const Rocks_HeadlessEvent* events;
+    uint32_t event_count;
+    // NULL measures every character as half the font size wide
+    Clay_Dimensions (*measure_text)(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData);
+    void* measure_user_data;
+    Clay_Dimensions image_size;     // Reported for every loaded image; nothing is decoded
+    Rocks_HeadlessFrameFunction on_frame;  // Called with each frame's commands instead of drawing them
+    void* frame_user_data;
+} Rocks_HeadlessConfig;
+
+struct Rocks {
+    Rocks_Config config;
+    Rocks_InputState input;
+    Clay_Arena clay_arena;
+    Clay_RenderCommandArray current_frame_commands;
+    void* renderer_data;
+    float global_scaling_factor;
+    bool is_running;
+};
+
+#endif // ROCKS_USE_HEADLESS
 
 #endif // ROCKS_TYPES_H
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "components/modal.h"
+#include <stdlib.h>
 
 static void Rocks_HandleBackdropClick(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData) {
     Rocks_Modal* modal = (Rocks_Modal*)userData;
@@ -67,6 +67,7 @@ void Rocks_UpdateTextInput(Rocks_TextInput* input, int key, float delta_time) {
         input->blink_timer -= ROCKS_CURSOR_BLINK_RATE;
         input->cursor_visible = !input->cursor_visible;
     }
+    Rocks_RequestFrameIn(ROCKS_CURSOR_BLINK_RATE - input->blink_timer);
 
     if (key == '\r' || key == '\n') {
         if (input->on_submit) {
@@ -141,6 +142,12 @@ void Rocks_UpdateTextInputFromRocksInput(Rocks_TextInput* input, Rocks_InputStat
     if (rocks_input.rightPressed) {
         Rocks_UpdateTextInput(input, 0x27, dt);
     }
+
+    // Keep the cursor blinking on frames without key presses
+    if (!rocks_input.charPressed && !rocks_input.enterPressed && !rocks_input.backspacePressed &&
+        !rocks_input.leftPressed && !rocks_input.rightPressed) {
+        Rocks_UpdateTextInput(input, 0, dt);
+    }
 }
 
 void Rocks_UnfocusTextInput(Rocks_TextInput* input) {
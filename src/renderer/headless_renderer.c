@@ -0,0 +1,313 @@
+#include "renderer/headless_renderer.h"
+#include "rocks.h"
+#include "rocks_custom.h"
+#include "rocks_damage.h"
+#include "rocks_measure_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ROCKS_USE_HEADLESS
+
+#define ROCKS_HEADLESS_DEFAULT_FRAME_TIME (1.0 / 60.0)
+#define ROCKS_HEADLESS_DEFAULT_IMAGE_SIZE 64.0f
+
+Clay_Dimensions Rocks_MeasureTextHeadless(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData) {
+    Rocks_HeadlessRenderer* r = userData;
+
+    int size = config->fontSize;
+    if (size == 0 && r && config->fontId < ROCKS_HEADLESS_MAX_FONTS) {
+        size = r->font_sizes[config->fontId];
+    }
+    if (size == 0) size = ROCKS_HEADLESS_DEFAULT_FONT_SIZE;
+
+    // Count characters, not UTF-8 bytes
+    int count = 0;
+    for (int32_t i = 0; i < text.length; i++) {
+        if (((unsigned char)text.chars[i] & 0xC0) != 0x80) count++;
+    }
+
+    float width = count * size * 0.5f;
+    if (count > 1) width += (count - 1) * config->letterSpacing;
+
+    // Height is the font size, as on the other backends; Clay applies
+    // lineHeight itself when it places the text
+    return (Clay_Dimensions){ width, size };
+}
+
+bool Rocks_InitHeadless(Rocks* rocks, void* config) {
+    if (!rocks) return false;
+
+    Rocks_HeadlessRenderer* r = calloc(1, sizeof(Rocks_HeadlessRenderer));
+    if (!r) return false;
+
+    if (config) {
+        r->config = *(Rocks_HeadlessConfig*)config;
+    }
+    if (r->config.frame_time <= 0) {
+        r->config.frame_time = ROCKS_HEADLESS_DEFAULT_FRAME_TIME;
+    }
+    if (r->config.image_size.width <= 0 || r->config.image_size.height <= 0) {
+        r->config.image_size = (Clay_Dimensions){
+            ROCKS_HEADLESS_DEFAULT_IMAGE_SIZE,
+            ROCKS_HEADLESS_DEFAULT_IMAGE_SIZE
+        };
+    }
+    r->rocks = rocks;
+
+    if (r->config.measure_text) {
+        Rocks_SetMeasureTextFunction(r->config.measure_text, r->config.measure_user_data);
+    } else {
+        Rocks_SetMeasureTextFunction(Rocks_MeasureTextHeadless, r);
+    }
+    rocks->renderer_data = r;
+
+    return true;
+}
+
+void Rocks_CleanupHeadless(Rocks* rocks) {
+    Rocks_HeadlessRenderer* r = rocks->renderer_data;
+    if (!r) return;
+
+    free(r->commands);
+    free(r);
+    rocks->renderer_data = NULL;
+}
+
+uint16_t Rocks_LoadFontHeadless(Rocks* rocks, const char* path, int size, uint16_t expected_id) {
+    Rocks_HeadlessRenderer* r = rocks->renderer_data;
+    if (!r || expected_id >= ROCKS_HEADLESS_MAX_FONTS) return UINT16_MAX;
+
+    // Nothing is rasterized, so the file is not opened
+    r->font_sizes[expected_id] = size > 0 ? size : ROCKS_HEADLESS_DEFAULT_FONT_SIZE;
+    return expected_id;
+}
+
+void Rocks_UnloadFontHeadless(Rocks* rocks, uint16_t font_id) {
+    Rocks_HeadlessRenderer* r = rocks->renderer_data;
+    if (!r || font_id >= ROCKS_HEADLESS_MAX_FONTS) return;
+    r->font_sizes[font_id] = 0;
+}
+
+static void* CreateImageHeadless(Rocks* rocks) {
+    Rocks_HeadlessRenderer* r = rocks->renderer_data;
+    if (!r) return NULL;
+
+    Clay_Dimensions* image = malloc(sizeof(Clay_Dimensions));
+    if (!image) return NULL;
+    *image = r->config.image_size;
+    return image;
+}
+
+void* Rocks_CreateDefaultImage(Rocks* rocks) {
+    return CreateImageHeadless(rocks);
+}
+
+void* Rocks_LoadImageHeadless(Rocks* rocks, const char* path) {
+    if (!path) return NULL;
+    return CreateImageHeadless(rocks);
+}
+
+void* Rocks_LoadImageFromMemoryHeadless(Rocks* rocks, const char* data, size_t length) {
+    if (!data || length == 0) return NULL;
+    return CreateImageHeadless(rocks);
+}
+
+void Rocks_UnloadImageHeadless(Rocks* rocks, void* image_data) {
+    free(image_data);
+}
+
+Clay_Dimensions Rocks_GetImageDimensionsHeadless(Rocks* rocks, void* image_data) {
+    if (!image_data) return (Clay_Dimensions){0, 0};
+    return *(Clay_Dimensions*)image_data;
+}
+
+void Rocks_SetWindowSizeHeadless(Rocks* rocks, int width, int height) {
+    Clay_SetLayoutDimensions((Clay_Dimensions){
+        width * rocks->global_scaling_factor,
+        height * rocks->global_scaling_factor
+    });
+}
+
+double Rocks_GetTimeHeadless(Rocks* rocks) {
+    Rocks_HeadlessRenderer* r = rocks ? rocks->renderer_data : NULL;
+    return r ? r->time : 0.0;
+}
+
+static void ApplyEventHeadless(Rocks* rocks, Rocks_HeadlessRenderer* r, const Rocks_HeadlessEvent* event) {
+    switch (event->type) {
+        case ROCKS_HEADLESS_EVENT_MOUSE_MOVE:
+            rocks->input.mousePositionX = event->x;
+            rocks->input.mousePositionY = event->y;
+            break;
+        case ROCKS_HEADLESS_EVENT_MOUSE_DOWN:
+            rocks->input.isMouseDown = true;
+            break;
+        case ROCKS_HEADLESS_EVENT_MOUSE_UP:
+            rocks->input.isMouseDown = false;
+            break;
+        case ROCKS_HEADLESS_EVENT_WHEEL:
+            r->wheel.x += event->x;
+            r->wheel.y += event->y;
+            break;
+        case ROCKS_HEADLESS_EVENT_TEXT:
+            // The input state holds one character per frame
+            rocks->input.charPressed = event->code;
+            break;
+        case ROCKS_HEADLESS_EVENT_KEY_ENTER:
+            rocks->input.enterPressed = true;
+            break;
+        case ROCKS_HEADLESS_EVENT_KEY_BACKSPACE:
+            rocks->input.backspacePressed = true;
+            break;
+        case ROCKS_HEADLESS_EVENT_KEY_LEFT:
+            rocks->input.leftPressed = true;
+            break;
+        case ROCKS_HEADLESS_EVENT_KEY_RIGHT:
+            rocks->input.rightPressed = true;
+            break;
+        case ROCKS_HEADLESS_EVENT_RESIZE:
+            rocks->config.window_width = (uint32_t)event->x;
+            rocks->config.window_height = (uint32_t)event->y;
+            break;
+        case ROCKS_HEADLESS_EVENT_QUIT:
+            rocks->is_running = false;
+            break;
+    }
+}
+
+void Rocks_ProcessEventsHeadless(Rocks* rocks) {
+    Rocks_HeadlessRenderer* r = rocks->renderer_data;
+    if (!r) return;
+
+    rocks->input.charPressed = 0;
+    rocks->input.enterPressed = false;
+    rocks->input.backspacePressed = false;
+    rocks->input.leftPressed = false;
+    rocks->input.rightPressed = false;
+    r->wheel = (Clay_Vector2){0, 0};
+
+    while (r->next_event < r->config.event_count &&
+           r->config.events[r->next_event].frame <= r->frame) {
+        ApplyEventHeadless(rocks, r, &r->config.events[r->next_event]);
+        r->next_event++;
+    }
+
+    rocks->input.scrollDeltaX = r->wheel.x;
+    rocks->input.scrollDeltaY = r->wheel.y;
+    Clay_UpdateScrollContainers(false, r->wheel, (float)r->config.frame_time);
+}
+
+void Rocks_RenderHeadless(Rocks* rocks, Clay_RenderCommandArray commands) {
+    Rocks_HeadlessRenderer* r = rocks->renderer_data;
+    if (!r) return;
+
+    // Clay reuses its command memory next frame, so keep a copy
+    if (commands.length > r->command_capacity) {
+        int32_t capacity = r->command_capacity > 0 ? r->command_capacity : 256;
+        while (capacity < commands.length) capacity *= 2;
+
+        Clay_RenderCommand* grown = realloc(r->commands, capacity * sizeof(Clay_RenderCommand));
+        if (grown) {
+            r->commands = grown;
+            r->command_capacity = capacity;
+        } else {
+            printf("Failed to grow headless command recording to %d commands\n", capacity);
+        }
+    }
+    r->command_count = commands.length <= r->command_capacity ? commands.length : 0;
+    if (r->command_count > 0) {
+        memcpy(r->commands, commands.internalArray, r->command_count * sizeof(Clay_RenderCommand));
+    }
+    r->total_commands += commands.length;
+
+    rocks->current_frame_commands = Rocks_GetRecordedCommandsHeadless(rocks);
+    if (r->config.on_frame) {
+        r->config.on_frame(rocks->current_frame_commands, r->frame, r->config.frame_user_data);
+    }
+
+    r->frame++;
+    r->time = r->frame * r->config.frame_time;
+    if (r->config.max_frames > 0 && r->frame >= r->config.max_frames) {
+        rocks->is_running = false;
+    }
+}
+
+Clay_RenderCommandArray Rocks_GetRecordedCommandsHeadless(Rocks* rocks) {
+    Rocks_HeadlessRenderer* r = rocks ? rocks->renderer_data : NULL;
+    if (!r) return (Clay_RenderCommandArray){0};
+
+    return (Clay_RenderCommandArray){
+        .capacity = r->command_capacity,
+        .length = r->command_count,
+        .internalArray = r->commands
+    };
+}
+
+#define HASH_FIELD(hash, field) Rocks_DamageHash((hash), &(field), sizeof(field))
+
+// Rocks_HashRenderCommand with the pointers it hashes replaced by what they
+// point at, since their addresses change from run to run
+static uint64_t HashCommandHeadless(const Clay_RenderCommand* cmd) {
+    uint64_t hash = ROCKS_DAMAGE_HASH_SEED;
+    const Clay_RenderData* data = &cmd->renderData;
+
+    switch (cmd->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE:
+            hash = HASH_FIELD(hash, data->image.backgroundColor);
+            hash = HASH_FIELD(hash, data->image.cornerRadius);
+            if (data->image.imageData) {
+                // Headless images are their dimensions
+                hash = Rocks_DamageHash(hash, data->image.imageData, sizeof(Clay_Dimensions));
+            }
+            break;
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM:
+            // The custom data belongs to the application, so only its
+            // presence is known
+            hash = HASH_FIELD(hash, data->custom.backgroundColor);
+            hash = HASH_FIELD(hash, data->custom.cornerRadius);
+            bool hasCustomData = data->custom.customData != NULL;
+            hash = HASH_FIELD(hash, hasCustomData);
+            break;
+        default:
+            hash = Rocks_HashRenderCommand(cmd);
+            break;
+    }
+
+    const RocksCustomData* custom = cmd->userData;
+    if (custom) {
+        hash = HASH_FIELD(hash, custom->cursorPointer);
+        hash = HASH_FIELD(hash, custom->shadowEnabled);
+        hash = HASH_FIELD(hash, custom->shadowColor);
+        hash = HASH_FIELD(hash, custom->shadowOffset);
+        hash = HASH_FIELD(hash, custom->shadowBlurRadius);
+        hash = HASH_FIELD(hash, custom->shadowSpread);
+        hash = HASH_FIELD(hash, custom->cachedLayer);
+        if (custom->link) {
+            hash = Rocks_DamageHash(hash, custom->link, strlen(custom->link) + 1);
+        }
+    }
+    return hash;
+}
+
+uint64_t Rocks_HashRecordedCommandsHeadless(Rocks* rocks) {
+    Rocks_HeadlessRenderer* r = rocks ? rocks->renderer_data : NULL;
+    uint64_t hash = ROCKS_DAMAGE_HASH_SEED;
+    if (!r) return hash;
+
+    for (int32_t i = 0; i < r->command_count; i++) {
+        const Clay_RenderCommand* cmd = &r->commands[i];
+        uint64_t content = HashCommandHeadless(cmd);
+        hash = Rocks_DamageHash(hash, &content, sizeof(content));
+        hash = Rocks_DamageHash(hash, &cmd->boundingBox, sizeof(Clay_BoundingBox));
+        hash = Rocks_DamageHash(hash, &cmd->id, sizeof(cmd->id));
+        hash = Rocks_DamageHash(hash, &cmd->commandType, sizeof(cmd->commandType));
+    }
+    return hash;
+}
+
+Rocks_HeadlessRenderer* Rocks_GetHeadlessRenderer(void) {
+    return GRocks ? GRocks->renderer_data : NULL;
+}
+
+#endif // ROCKS_USE_HEADLESS
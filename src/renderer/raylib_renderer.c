@@ -2,7 +2,10 @@
 #include <math.h>
 #include <string.h>
 #include "raymath.h"
+#include "rlgl.h"
 #include "rocks_custom.h"
+#include "rocks_measure_cache.h"
+#include "rocks_profile.h"
 
 
 #define NANOSVG_IMPLEMENTATION 
@@ -11,7 +14,6 @@
 #define NANOSVGRAST_IMPLEMENTATION
 #include "nanosvgrast.h"
 
-#define MAX_SCROLL_CONTAINERS 32
 #define SCROLLBAR_SIZE 10.0f
 #define SCROLLBAR_FADE_DURATION 0.6f
 #define SCROLLBAR_HIDE_DELAY 0.6f
@@ -19,24 +21,194 @@
 
 static Rocks_ScrollState g_scroll_state = {0};
 
+// Distance field text shader, from raylib's text_font_sdf example
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_WEB)
+static const char* ROCKS_SDF_FRAGMENT_SHADER =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "void main() {\n"
+    "    float distanceFromOutline = texture2D(texture0, fragTexCoord).a - 0.5;\n"
+    "    float distanceChangePerFragment = length(vec2(dFdx(distanceFromOutline), dFdy(distanceFromOutline)));\n"
+    "    float alpha = smoothstep(-distanceChangePerFragment, distanceChangePerFragment, distanceFromOutline);\n"
+    "    gl_FragColor = vec4(fragColor.rgb, fragColor.a*alpha);\n"
+    "}\n";
+#else
+static const char* ROCKS_SDF_FRAGMENT_SHADER =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float distanceFromOutline = texture(texture0, fragTexCoord).a - 0.5;\n"
+    "    float distanceChangePerFragment = length(vec2(dFdx(distanceFromOutline), dFdy(distanceFromOutline)));\n"
+    "    float alpha = smoothstep(-distanceChangePerFragment, distanceChangePerFragment, distanceFromOutline);\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a*alpha);\n"
+    "}\n";
+#endif
+
 // Helper functions
+static void BuildAsciiMetricsRaylib(Font font, Rocks_AsciiMetrics* metrics) {
+    memset(metrics, 0, sizeof(Rocks_AsciiMetrics));
+    if (!font.glyphs || !font.recs) return;
+
+    // Mirrors the per-glyph width MeasureTextEx uses; raylib has no kerning
+    for (int c = ROCKS_ASCII_FIRST; c <= ROCKS_ASCII_LAST; c++) {
+        int index = GetGlyphIndex(font, c);
+        float advance = font.glyphs[index].advanceX != 0 ?
+            (float)font.glyphs[index].advanceX :
+            font.recs[index].width + font.glyphs[index].offsetX;
+
+        metrics->advances[c] = advance;
+        metrics->max_x[c] = advance;
+    }
+
+    metrics->line_height = (float)font.baseSize;
+    metrics->valid = true;
+}
+
+// Builds a single distance field atlas that renders crisply at any size
+static Font LoadFontSDF(const Rocks_FontFace* face) {
+    Font font = {0};
+    font.baseSize = ROCKS_SDF_FONT_BASE_SIZE;
+    font.glyphCount = 95;
+    font.glyphs = LoadFontData(face->data, (int)face->size, font.baseSize, NULL, font.glyphCount, FONT_SDF);
+
+    if (!font.glyphs) return (Font){0};
+
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, font.baseSize, 0, 1);
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    return font;
+}
+
+static void ReleaseFontVariantRaylib(Rocks_RaylibFontVariant* variant) {
+    if (variant->font.baseSize) {
+        UnloadFont(variant->font);
+    }
+    Rocks_FreeAsciiMetrics(&variant->ascii);
+    memset(variant, 0, sizeof(Rocks_RaylibFontVariant));
+}
+
+static void ReleaseLayerRaylib(void* entry) {
+    Rocks_RaylibLayer* layer = entry;
+    if (layer->target.id) {
+        UnloadRenderTexture(layer->target);
+    }
+    if (layer->spare.id) {
+        UnloadRenderTexture(layer->spare);
+    }
+    Rocks_FreeDamageTracker(&layer->damage);
+    *layer = (Rocks_RaylibLayer){0};
+}
+
+static void ReleaseFontRaylib(Rocks_RaylibFont* entry) {
+    for (int i = 0; i < entry->variant_set.count; i++) {
+        Rocks_RaylibFontVariant* variant = entry->variant_set.slots[i].variant;
+        if (!variant) continue;
+        ReleaseFontVariantRaylib(variant);
+        free(variant);
+    }
+    Rocks_FreeFontVariantSet(&entry->variant_set);
+    Rocks_ReleaseFontFace(entry->face);
+    memset(entry, 0, sizeof(Rocks_RaylibFont));
+}
+
+// Loads the requested size from the shared face on first use, reusing the
+// slot of a size that has gone unused once the font id holds
+// ROCKS_FONT_VARIANT_SOFT_LIMIT
+static Rocks_RaylibFontVariant* GetFontVariantRaylib(Rocks_RaylibRenderer* r, uint16_t font_id, uint16_t font_size) {
+    if (font_id >= 32 || !r->fonts[font_id].face) return NULL;
+
+    Rocks_RaylibFont* entry = &r->fonts[font_id];
+    int size = entry->sdf ?
+        ROCKS_SDF_FONT_BASE_SIZE :
+        (int)((font_size > 0 ? font_size : entry->size) * r->scale_factor);
+    if (size <= 0) return NULL;
+
+    bool needs_load = false;
+    int slot = Rocks_AcquireFontVariant(&entry->variant_set, size, Rocks_GetFrameIndex(), &needs_load);
+    if (slot < 0) return NULL;
+
+    Rocks_RaylibFontVariant* variant = entry->variant_set.slots[slot].variant;
+    if (!needs_load) return variant;
+
+    if (variant) {
+        ReleaseFontVariantRaylib(variant);
+    } else {
+        variant = calloc(1, sizeof(Rocks_RaylibFontVariant));
+        if (!variant) return NULL;
+        entry->variant_set.slots[slot].variant = variant;
+    }
+
+    ROCKS_PROFILE_BEGIN(font_raster);
+    variant->font = entry->sdf ?
+        LoadFontSDF(entry->face) :
+        LoadFontFromMemory(GetFileExtension(entry->face->path), entry->face->data, (int)entry->face->size, size, NULL, 0);
+    ROCKS_PROFILE_END(font_raster);
+    if (variant->font.baseSize == 0) {
+        printf("ERROR: Could not load font %s at %dpx\n", entry->face->path, size);
+        Rocks_SetFontVariant(&entry->variant_set, slot, 0);
+        return NULL;
+    }
+
+    BuildAsciiMetricsRaylib(variant->font, &variant->ascii);
+    Rocks_SetFontVariant(&entry->variant_set, slot, size);
+    return variant;
+}
+
+// Copies text into a grow-only scratch buffer, terminated for raylib's
+// string functions. NULL when the buffer cannot grow.
+static char* TerminateTextRaylib(char** buffer, size_t* size, Clay_StringSlice text) {
+    if (*size < (size_t)text.length + 1) {
+        char* grown = realloc(*buffer, text.length + 1);
+        if (!grown) return NULL;
+        *buffer = grown;
+        *size = text.length + 1;
+    }
+
+    memcpy(*buffer, text.chars, text.length);
+    (*buffer)[text.length] = '\0';
+    return *buffer;
+}
+
 Clay_Dimensions Rocks_MeasureTextRaylib(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData) {
     Rocks_RaylibRenderer* r = (Rocks_RaylibRenderer*)userData;
-    if (!text.chars || text.length == 0 || config->fontId >= 32 || !r->fonts[config->fontId].font.baseSize) {
+    if (!text.chars || text.length == 0) {
         return (Clay_Dimensions){0, 0};
     }
 
-    char* buffer = malloc(text.length + 1);
-    if (!buffer) return (Clay_Dimensions){0, 0};
-    
-    memcpy(buffer, text.chars, text.length);
-    buffer[text.length] = '\0';
+    Rocks_RaylibFontVariant* variant = GetFontVariantRaylib(r, config->fontId, config->fontSize);
+    if (!variant) {
+        return (Clay_Dimensions){0, 0};
+    }
 
-    Font font = r->fonts[config->fontId].font;
-    Vector2 textSize = MeasureTextEx(font, buffer, (float)font.baseSize, 0);
-    
-    free(buffer);
-    return (Clay_Dimensions){textSize.x, textSize.y};
+    // Variant pixels to layout units, the same for bitmap and SDF fonts
+    Rocks_RaylibFont* entry = &r->fonts[config->fontId];
+    float size = config->fontSize > 0 ? config->fontSize : entry->size;
+    float size_ratio = Rocks_FontLayoutRatio(entry->sdf, size, variant->font.baseSize, r->scale_factor);
+
+    Rocks_AsciiMetrics* ascii = &variant->ascii;
+    if (ascii->valid && Rocks_IsPrintableAscii(text)) {
+        return (Clay_Dimensions){
+            Rocks_MeasureAsciiWidth(ascii, text) * size_ratio,
+            ascii->line_height * size_ratio
+        };
+    }
+
+    const char* terminated = TerminateTextRaylib(&r->measure_buffer, &r->measure_buffer_size, text);
+    if (!terminated) return (Clay_Dimensions){0, 0};
+
+    Font font = variant->font;
+    Vector2 textSize = MeasureTextEx(font, terminated, font.baseSize, 0);
+
+    return (Clay_Dimensions){textSize.x * size_ratio, textSize.y * size_ratio};
 }
 
 static bool IsInsideModal(Vector2 point) {
@@ -56,34 +228,21 @@ static bool IsInsideModal(Vector2 point) {
     return false;
 }
 
-static void UpdateScrollState(Rocks_RaylibRenderer* r) {
-    const float DECELERATION = 0.95f;
-    const float MIN_VELOCITY = 0.1f;
-    
-    float deltaTime = GetFrameTime();
-    
-    for (int i = 0; i < r->scroll_container_count; i++) {
-        Clay_ElementId elementId = {.id = r->scroll_containers[i].elementId};
-        Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
-        
-        if (!scrollData.found) continue;
-
-        if (fabsf(g_scroll_state.velocity_x) > MIN_VELOCITY) {
-            scrollData.scrollPosition->x += g_scroll_state.velocity_x * deltaTime;
-            g_scroll_state.velocity_x *= DECELERATION;
-        }
+// Containers behind an open modal do not scroll
+static bool IsScrollEntryLive(const Rocks_ScrollEntry* entry) {
+    return !GActiveModal || IsInsideModal((Vector2){entry->bounds.x, entry->bounds.y});
+}
 
-        if (fabsf(g_scroll_state.velocity_y) > MIN_VELOCITY) {
-            scrollData.scrollPosition->y += g_scroll_state.velocity_y * deltaTime;
-            g_scroll_state.velocity_y *= DECELERATION;
-        }
+// Innermost live scroll container under the point, or NULL
+static const Rocks_ScrollEntry* ScrollEntryAtRaylib(Rocks_RaylibRenderer* r, Vector2 point) {
+    const Rocks_ScrollEntry* entry = Rocks_ScrollEntryAt(&r->scroll_registry, point.x, point.y);
+    return entry && IsScrollEntryLive(entry) ? entry : NULL;
+}
 
-        // Clamp scroll positions
-        float maxScrollX = -(scrollData.contentDimensions.width - scrollData.scrollContainerDimensions.width);
-        float maxScrollY = -(scrollData.contentDimensions.height - scrollData.scrollContainerDimensions.height);
-        
-        scrollData.scrollPosition->x = Clamp(scrollData.scrollPosition->x, maxScrollX, 0);
-        scrollData.scrollPosition->y = Clamp(scrollData.scrollPosition->y, maxScrollY, 0);
+// Flung containers keep the loop awake until they come to rest
+static void UpdateScrollState(Rocks_RaylibRenderer* r) {
+    if (Rocks_StepScrollPhysics(&r->scroll_physics, GetTime())) {
+        Rocks_RequestFrame();
     }
 }
 
@@ -159,32 +318,13 @@ static void RenderScrollbar(
     DrawRectangleRec(thumb, thumbColor);
 }
 static void UpdateCursor(Rocks_RaylibRenderer* r) {
-    bool hasPointerElement = false;
     Vector2 mousePos = GetMousePosition();
-    mousePos.x /= r->scale_factor;
-    mousePos.y /= r->scale_factor;
-
-    for (uint32_t i = 0; i < r->rocks->current_frame_commands.length; i++) {
-
-        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&r->rocks->current_frame_commands, i);
-        if (!cmd || !cmd->userData) continue;
-            
-        RocksCustomData* customData = (RocksCustomData*)cmd->userData;
-
-        if (customData->cursorPointer) {
-            Rectangle bounds = {
-                cmd->boundingBox.x,
-                cmd->boundingBox.y,
-                cmd->boundingBox.width,
-                cmd->boundingBox.height
-            };
-
-            if (CheckCollisionPointRec(mousePos, bounds)) {
-                hasPointerElement = true;
-                break;
-            }
-        }
-    }
+    bool hasPointerElement = Rocks_HitTest(
+        &r->hit_index,
+        mousePos.x / r->scale_factor,
+        mousePos.y / r->scale_factor,
+        ROCKS_HIT_CURSOR_POINTER
+    ) != NULL;
 
     SetMouseCursor(hasPointerElement ? MOUSE_CURSOR_POINTING_HAND : MOUSE_CURSOR_DEFAULT);
 }
@@ -239,6 +379,31 @@ void Rocks_ToggleFullscreenRaylib(Rocks* rocks) {
 
 
 // Initialization
+// Scrollbars are drawn from scroll state rather than render data, so their
+// position, fade and a pointer over them feed the damage hash
+static uint64_t HashScrollbarStateRaylib(const Clay_RenderCommand* cmd, void* userData) {
+    if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) return 0;
+
+    Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData((Clay_ElementId){ .id = cmd->id });
+    if (!scrollData.found) return 0;
+
+    Rocks_RaylibRenderer* r = userData;
+    uint64_t hash = ROCKS_DAMAGE_HASH_SEED;
+    hash = Rocks_DamageHash(hash, scrollData.scrollPosition, sizeof(Clay_Vector2));
+    hash = Rocks_DamageHash(hash, &scrollData.contentDimensions, sizeof(Clay_Dimensions));
+    hash = Rocks_DamageHash(hash, &r->scrollbar_opacity, sizeof(float));
+
+    // Same strip RenderScrollbar hit tests the thumb in
+    Vector2 mousePos = GetMousePosition();
+    float scrollbarSize = SCROLLBAR_SIZE * r->scale_factor;
+    Rectangle box = { cmd->boundingBox.x, cmd->boundingBox.y, cmd->boundingBox.width, cmd->boundingBox.height };
+    if (CheckCollisionPointRec(mousePos, box) &&
+        (mousePos.x >= box.x + box.width - scrollbarSize || mousePos.y >= box.y + box.height - scrollbarSize)) {
+        hash = Rocks_DamageHash(hash, &mousePos, sizeof(Vector2));
+    }
+    return hash;
+}
+
 bool Rocks_InitRaylib(Rocks* rocks, void* config) {
     if (!rocks || !config) return false;
 
@@ -249,18 +414,34 @@ bool Rocks_InitRaylib(Rocks* rocks, void* config) {
     
     r->scale_factor = raylib_config->scale_factor > 0 ? raylib_config->scale_factor : 1.0f;
     r->rocks = rocks;
+    Rocks_InitLayerTable(&r->layer_table, r->layers, sizeof(Rocks_RaylibLayer), ReleaseLayerRaylib);
     r->scrollbar_opacity = 0.0f;
     r->last_mouse_move_time = 0.0f;
     
-    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    unsigned int flags = FLAG_WINDOW_RESIZABLE;
+    if (raylib_config->vsync || rocks->config.frame_pacing == ROCKS_FRAME_PACING_VSYNC) {
+        flags |= FLAG_VSYNC_HINT;
+    }
+    SetConfigFlags(flags);
     InitWindow(
         rocks->config.window_width * r->scale_factor,
         rocks->config.window_height * r->scale_factor,
         rocks->config.window_title
     );
-    
-    SetTargetFPS(60);
-    Clay_SetMeasureTextFunction(Rocks_MeasureTextRaylib, (void*)(uintptr_t)r);
+
+    // Frames are paced by Rocks_Run, see Rocks_Config.frame_pacing
+    SetTargetFPS(0);
+
+    r->sdf_fonts = raylib_config->sdf_fonts;
+    if (r->sdf_fonts) {
+        r->sdf_shader = LoadShaderFromMemory(NULL, ROCKS_SDF_FRAGMENT_SHADER);
+    }
+
+    Rocks_InitShapeBatchRaylib(&r->shapes);
+    r->damage.extra_hash = HashScrollbarStateRaylib;
+    r->damage.user_data = r;
+
+    Rocks_SetMeasureTextFunction(Rocks_MeasureTextRaylib, (void*)(uintptr_t)r);
     rocks->renderer_data = r;
 
     return true;
@@ -271,12 +452,27 @@ void Rocks_CleanupRaylib(Rocks* rocks) {
     if (!r) return;
 
     for (int i = 0; i < 32; i++) {
-        if (r->fonts[i].font.baseSize) {
-            UnloadFont(r->fonts[i].font);
-        }
+        ReleaseFontRaylib(&r->fonts[i]);
     }
 
+    if (r->sdf_fonts) {
+        UnloadShader(r->sdf_shader);
+    }
+    Rocks_CleanupShapeBatchRaylib(&r->shapes);
+
+    if (r->backbuffer.id) {
+        UnloadRenderTexture(r->backbuffer);
+    }
+    Rocks_FreeDamageTracker(&r->damage);
+    Rocks_FreeHitIndex(&r->hit_index);
+    Rocks_FreeScrollRegistry(&r->scroll_registry);
+    Rocks_FreeScrollPhysics(&r->scroll_physics);
+    Rocks_ClearLayerTable(&r->layer_table);
+    free(r->layer_commands);
+
     CloseWindow();
+    free(r->measure_buffer);
+    free(r->draw_buffer);
     free(r);
 }
 
@@ -284,14 +480,20 @@ uint16_t Rocks_LoadFontRaylib(Rocks* rocks, const char* path, int size, uint16_t
     Rocks_RaylibRenderer* r = rocks->renderer_data;
     if (!r || expected_id >= 32) return UINT16_MAX;
 
-    if (r->fonts[expected_id].font.baseSize) {
-        UnloadFont(r->fonts[expected_id].font);
-    }
+    ReleaseFontRaylib(&r->fonts[expected_id]);
 
-    Font font = LoadFontEx(path, size * r->scale_factor, NULL, 0);
-    if (font.baseSize == 0) return UINT16_MAX;
+    Rocks_RaylibFont* entry = &r->fonts[expected_id];
+    entry->face = Rocks_AcquireFontFace(path);
+    if (!entry->face) return UINT16_MAX;
+    entry->size = size;
+    entry->sdf = r->sdf_fonts;
+
+    // Load the default size up front so a bad font fails here, not mid-frame
+    if (!GetFontVariantRaylib(r, expected_id, 0)) {
+        ReleaseFontRaylib(entry);
+        return UINT16_MAX;
+    }
 
-    r->fonts[expected_id].font = font;
     return expected_id;
 }
 
@@ -299,10 +501,9 @@ void Rocks_UnloadFontRaylib(Rocks* rocks, uint16_t font_id) {
     Rocks_RaylibRenderer* r = rocks->renderer_data;
     if (!r || font_id >= 32) return;
 
-    if (r->fonts[font_id].font.baseSize) {
-        UnloadFont(r->fonts[font_id].font);
-        r->fonts[font_id].font = (Font){0};
-    }
+    ReleaseFontRaylib(&r->fonts[font_id]);
+    Rocks_InvalidateDamage(&r->damage);
+    Rocks_InvalidateLayerTable(&r->layer_table);
 }
 
 
@@ -444,19 +645,25 @@ void* Rocks_LoadImageRaylib(Rocks* rocks, const char* path) {
             return Rocks_CreateDefaultImage(rocks);
         }
         
+        ROCKS_PROFILE_BEGIN(image_upload);
         *texture = LoadTextureFromImage(image);
+        ROCKS_PROFILE_END(image_upload);
         UnloadImage(image);
         
     } else {
         // Regular image loading
+        ROCKS_PROFILE_BEGIN(image_decode);
         Image image = LoadImage(path);
+        ROCKS_PROFILE_END(image_decode);
         if (!image.data) {
             free(texture);
             TraceLog(LOG_WARNING, "Failed to load image: %s", path);
             return Rocks_CreateDefaultImage(rocks);
         }
         
+        ROCKS_PROFILE_BEGIN(image_upload);
         *texture = LoadTextureFromImage(image);
+        ROCKS_PROFILE_END(image_upload);
         UnloadImage(image);
     }
 
@@ -533,7 +740,9 @@ void* Rocks_LoadImageFromMemoryRaylib(Rocks* rocks, const char* data, size_t len
         return Rocks_CreateDefaultImage(rocks);
     }
     
+    ROCKS_PROFILE_BEGIN(image_upload);
     *texture = LoadTextureFromImage(image);
+    ROCKS_PROFILE_END(image_upload);
     UnloadImage(image);
     
     if (texture->id == 0) {
@@ -556,9 +765,26 @@ Clay_Dimensions Rocks_GetImageDimensionsRaylib(Rocks* rocks, void* image_data) {
     return (Clay_Dimensions){(float)texture->width, (float)texture->height};
 }
 
-float Rocks_GetTimeRaylib(void) {
+double Rocks_GetTimeRaylib(void) {
     return GetTime();
 }
+
+float Rocks_GetRefreshRateRaylib(void) {
+    return (float)GetMonitorRefreshRate(GetCurrentMonitor());
+}
+
+// raylib waits for events inside EndDrawing, so this decides whether the
+// frame being drawn is the last one before the loop sleeps
+void Rocks_SetEventWaitingRaylib(bool wait) {
+    static bool waiting = false;
+    if (wait == waiting) return;
+    waiting = wait;
+    if (wait) {
+        EnableEventWaiting();
+    } else {
+        DisableEventWaiting();
+    }
+}
 void Rocks_ProcessEventsRaylib(Rocks* rocks) {
     Rocks_RaylibRenderer* r = rocks->renderer_data;
     if (!r) return;
@@ -614,25 +840,8 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
             }
         }
 
-        if (!GActiveModal || insideModal) {
-            for (int i = 0; i < r->scroll_container_count; i++) {
-                Clay_ElementId elementId = {.id = r->scroll_containers[i].elementId};
-                Clay_ElementData elementData = Clay_GetElementData(elementId);
-                
-                if (elementData.found) {
-                    Rectangle bounds = {
-                        elementData.boundingBox.x,
-                        elementData.boundingBox.y,
-                        elementData.boundingBox.width,
-                        elementData.boundingBox.height
-                    };
-                    
-                    if (CheckCollisionPointRec(mousePos, bounds)) {
-                        r->last_mouse_move_time = GetTime();
-                        break;
-                    }
-                }
-            }
+        if ((!GActiveModal || insideModal) && ScrollEntryAtRaylib(r, mousePos)) {
+            r->last_mouse_move_time = GetTime();
         }
         
         lastMousePos = mousePos;
@@ -645,26 +854,10 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
         mousePos.y /= r->scale_factor;
         
         // Check for link clicks first
-        bool linkClicked = false;
-        for (uint32_t i = 0; i < rocks->current_frame_commands.length; i++) {
-            Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&rocks->current_frame_commands, i);
-            if (!cmd || !cmd->userData) continue;
-
-            RocksCustomData* customData = (RocksCustomData*)cmd->userData;
-            if (customData->link) {
-                Rectangle bounds = {
-                    cmd->boundingBox.x,
-                    cmd->boundingBox.y,
-                    cmd->boundingBox.width,
-                    cmd->boundingBox.height
-                };
-
-                if (CheckCollisionPointRec(mousePos, bounds)) {
-                    OpenURL(customData->link);
-                    linkClicked = true;
-                    break;
-                }
-            }
+        const Rocks_HitEntry* link = Rocks_HitTest(&r->hit_index, mousePos.x, mousePos.y, ROCKS_HIT_LINK);
+        bool linkClicked = link != NULL;
+        if (link) {
+            OpenURL(link->data->link);
         }
 
         // Only proceed if no link was clicked
@@ -687,80 +880,64 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
 
             // Only check containers if we're either inside modal or no modal is active
             if (!GActiveModal || insideModal) {
-                bool containerClicked = false;
-                for (int i = 0; i < r->scroll_container_count; i++) {
-                    Clay_ElementId elementId = {.id = r->scroll_containers[i].elementId};
-                    Clay_ElementData elementData = Clay_GetElementData(elementId);
-                    
-                    if (elementData.found) {
-                        Rectangle bounds = {
-                            elementData.boundingBox.x,
-                            elementData.boundingBox.y,
-                            elementData.boundingBox.width,
-                            elementData.boundingBox.height
-                        };
+                const Rocks_ScrollEntry* entry = ScrollEntryAtRaylib(r, mousePos);
+                bool containerClicked = entry != NULL;
+                if (entry) {
+                    r->last_mouse_move_time = GetTime();
+                    g_scroll_state.is_dragging = true;
+                    g_scroll_state.drag_start = (Clay_Vector2){mousePos.x, mousePos.y};
+                    g_scroll_state.active_container_id = entry->id;
+                    Rocks_StopScroll(&r->scroll_physics, entry->id);
+
+                    Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData((Clay_ElementId){.id = entry->id});
+                    if (scrollData.found) {
+                        Rectangle verticalThumb = {0};
+                        Rectangle horizontalThumb = {0};
+                        
+                        if (scrollData.config.vertical) {
+                            float viewportSize = scrollData.scrollContainerDimensions.height;
+                            float contentSize = scrollData.contentDimensions.height;
+                            float thumbSize = fmaxf((viewportSize / contentSize) * viewportSize, SCROLLBAR_SIZE * r->scale_factor * 2);
+                            float maxScroll = contentSize - viewportSize;
+                            float scrollProgress = -scrollData.scrollPosition->y / maxScroll;
+                            float maxTrackSize = viewportSize - thumbSize;
+                            float thumbPosition = scrollProgress * maxTrackSize;
+                            
+                            verticalThumb = (Rectangle){
+                                (entry->bounds.x + entry->bounds.width - SCROLLBAR_SIZE * r->scale_factor),
+                                entry->bounds.y + thumbPosition,
+                                SCROLLBAR_SIZE * r->scale_factor,
+                                thumbSize
+                            };
+                        }
                         
-                        if (CheckCollisionPointRec(mousePos, bounds)) {
-                            r->last_mouse_move_time = GetTime();
-                            g_scroll_state.is_dragging = true;
-                            g_scroll_state.drag_start = (Clay_Vector2){mousePos.x, mousePos.y};
-                            g_scroll_state.active_container_id = r->scroll_containers[i].elementId;
-                            containerClicked = true;
-
-                            Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
-                            if (scrollData.found) {
-                                Rectangle verticalThumb = {0};
-                                Rectangle horizontalThumb = {0};
-                                
-                                if (scrollData.config.vertical) {
-                                    float viewportSize = scrollData.scrollContainerDimensions.height;
-                                    float contentSize = scrollData.contentDimensions.height;
-                                    float thumbSize = fmaxf((viewportSize / contentSize) * viewportSize, SCROLLBAR_SIZE * r->scale_factor * 2);
-                                    float maxScroll = contentSize - viewportSize;
-                                    float scrollProgress = -scrollData.scrollPosition->y / maxScroll;
-                                    float maxTrackSize = viewportSize - thumbSize;
-                                    float thumbPosition = scrollProgress * maxTrackSize;
-                                    
-                                    verticalThumb = (Rectangle){
-                                        (elementData.boundingBox.x + elementData.boundingBox.width - SCROLLBAR_SIZE * r->scale_factor),
-                                        elementData.boundingBox.y + thumbPosition,
-                                        SCROLLBAR_SIZE * r->scale_factor,
-                                        thumbSize
-                                    };
-                                }
-                                
-                                if (scrollData.config.horizontal) {
-                                    float viewportSize = scrollData.scrollContainerDimensions.width;
-                                    float contentSize = scrollData.contentDimensions.width;
-                                    float thumbSize = fmaxf((viewportSize / contentSize) * viewportSize, SCROLLBAR_SIZE * r->scale_factor * 2);
-                                    float maxScroll = contentSize - viewportSize;
-                                    float scrollProgress = -scrollData.scrollPosition->x / maxScroll;
-                                    float maxTrackSize = viewportSize - thumbSize;
-                                    float thumbPosition = scrollProgress * maxTrackSize;
-                                    
-                                    horizontalThumb = (Rectangle){
-                                        elementData.boundingBox.x + thumbPosition,
-                                        (elementData.boundingBox.y + elementData.boundingBox.height - SCROLLBAR_SIZE * r->scale_factor),
-                                        thumbSize,
-                                        SCROLLBAR_SIZE * r->scale_factor
-                                    };
-                                }
-
-                                if (CheckCollisionPointRec(mousePos, verticalThumb)) {
-                                    g_scroll_state.is_dragging_handle = true;
-                                    g_scroll_state.vertical_scrollbar = true;
-                                    g_scroll_state.active_scrollbar_id = r->scroll_containers[i].elementId;
-                                    g_scroll_state.scroll_start = *scrollData.scrollPosition;
-                                    break;
-                                } else if (CheckCollisionPointRec(mousePos, horizontalThumb)) {
-                                    g_scroll_state.is_dragging_handle = true;
-                                    g_scroll_state.vertical_scrollbar = false;
-                                    g_scroll_state.active_scrollbar_id = r->scroll_containers[i].elementId;
-                                    g_scroll_state.scroll_start = *scrollData.scrollPosition;
-                                    break;
-                                }
-                            }
-                            break;
+                        if (scrollData.config.horizontal) {
+                            float viewportSize = scrollData.scrollContainerDimensions.width;
+                            float contentSize = scrollData.contentDimensions.width;
+                            float thumbSize = fmaxf((viewportSize / contentSize) * viewportSize, SCROLLBAR_SIZE * r->scale_factor * 2);
+                            float maxScroll = contentSize - viewportSize;
+                            float scrollProgress = -scrollData.scrollPosition->x / maxScroll;
+                            float maxTrackSize = viewportSize - thumbSize;
+                            float thumbPosition = scrollProgress * maxTrackSize;
+                            
+                            horizontalThumb = (Rectangle){
+                                entry->bounds.x + thumbPosition,
+                                (entry->bounds.y + entry->bounds.height - SCROLLBAR_SIZE * r->scale_factor),
+                                thumbSize,
+                                SCROLLBAR_SIZE * r->scale_factor
+                            };
+                        }
+
+                        if (CheckCollisionPointRec(mousePos, verticalThumb)) {
+                            g_scroll_state.is_dragging_handle = true;
+                            g_scroll_state.vertical_scrollbar = true;
+                            g_scroll_state.active_scrollbar_id = entry->id;
+                            g_scroll_state.scroll_start = *scrollData.scrollPosition;
+                        } else if (CheckCollisionPointRec(mousePos, horizontalThumb)) {
+                            g_scroll_state.is_dragging_handle = true;
+                            g_scroll_state.vertical_scrollbar = false;
+                            g_scroll_state.active_scrollbar_id = entry->id;
+                            g_scroll_state.scroll_start = *scrollData.scrollPosition;
                         }
                     }
                 }
@@ -774,6 +951,9 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
     }
 
     if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+        if (g_scroll_state.is_dragging && !g_scroll_state.is_dragging_handle) {
+            Rocks_ReleaseScroll(&r->scroll_physics, g_scroll_state.active_container_id, GetTime());
+        }
         g_scroll_state.is_dragging = false;
         g_scroll_state.is_dragging_handle = false;
     }
@@ -813,19 +993,11 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
             Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
             
             if (scrollData.found) {
-                if (scrollData.config.vertical) {
-                    scrollData.scrollPosition->y += dragDelta.y;
-                    float maxScrollY = -(scrollData.contentDimensions.height - scrollData.scrollContainerDimensions.height);
-                    scrollData.scrollPosition->y = Clamp(scrollData.scrollPosition->y, maxScrollY, 0);
-                }
-                if (scrollData.config.horizontal) {
-                    scrollData.scrollPosition->x += dragDelta.x;
-                    float maxScrollX = -(scrollData.contentDimensions.width - scrollData.scrollContainerDimensions.width);
-                    scrollData.scrollPosition->x = Clamp(scrollData.scrollPosition->x, maxScrollX, 0);
-                }
-                
-                g_scroll_state.velocity_x = (mousePos.x - g_scroll_state.drag_start.x) / GetFrameTime();
-                g_scroll_state.velocity_y = (mousePos.y - g_scroll_state.drag_start.y) / GetFrameTime();
+                Clay_Vector2 delta = {
+                    scrollData.config.horizontal ? dragDelta.x : 0,
+                    scrollData.config.vertical ? dragDelta.y : 0
+                };
+                Rocks_DragScroll(&r->scroll_physics, g_scroll_state.active_container_id, &scrollData, delta, GetTime());
             }
             
             g_scroll_state.drag_start = (Clay_Vector2){mousePos.x, mousePos.y};
@@ -858,45 +1030,33 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
 
         // Only process wheel scrolling if we're either inside modal or no modal is active
         if (!GActiveModal || insideModal) {
-            bool containerFound = false;
-            for (int i = 0; i < r->scroll_container_count; i++) {
-                Clay_ElementId elementId = {.id = r->scroll_containers[i].elementId};
-                Clay_ElementData elementData = Clay_GetElementData(elementId);
-                Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
-                
-                if (elementData.found && scrollData.found) {
-                    Rectangle bounds = {
-                        elementData.boundingBox.x,
-                        elementData.boundingBox.y,
-                        elementData.boundingBox.width,
-                        elementData.boundingBox.height
-                    };
-                    
-                    if (CheckCollisionPointRec(mousePos, bounds)) {
-                        const float SCROLL_SPEED = 30.0f;
-                        
-                        if (scrollData.config.vertical) {
-                            scrollData.scrollPosition->y += wheelMove * SCROLL_SPEED;
-                            float maxScrollY = -(scrollData.contentDimensions.height - scrollData.scrollContainerDimensions.height);
-                            scrollData.scrollPosition->y = Clamp(scrollData.scrollPosition->y, maxScrollY, 0);
-                        } 
-                        else if (scrollData.config.horizontal) {
-                            scrollData.scrollPosition->x += wheelMove * SCROLL_SPEED;
-                            float maxScrollX = -(scrollData.contentDimensions.width - scrollData.scrollContainerDimensions.width);
-                            scrollData.scrollPosition->x = Clamp(scrollData.scrollPosition->x, maxScrollX, 0);
-                        }
-                        
-                        containerFound = true;
-                        break;
-                    }
+            const float SCROLL_SPEED = 30.0f;
+
+            // Containers that cannot move that way pass the wheel outwards
+            const Rocks_ScrollEntry* entry = ScrollEntryAtRaylib(r, mousePos);
+            for (; entry && IsScrollEntryLive(entry); entry = Rocks_GetScrollParent(&r->scroll_registry, entry)) {
+                Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData((Clay_ElementId){.id = entry->id});
+                if (!scrollData.found) continue;
+
+                // The wheel move is fractional for trackpads
+                Clay_Vector2 delta = {0, 0};
+                if (scrollData.config.vertical) {
+                    delta.y = wheelMove * SCROLL_SPEED;
+                } 
+                else if (scrollData.config.horizontal) {
+                    delta.x = wheelMove * SCROLL_SPEED;
                 }
+                if (!Rocks_CanScrollBy(&scrollData, delta)) continue;
+
+                Rocks_ScrollBy(&r->scroll_physics, entry->id, &scrollData, delta);
+                break;
             }
         }
     }
 
     // Update scrollbar fade
-    float currentTime = GetTime();
-    float timeSinceLastMove = currentTime - r->last_mouse_move_time;
+    double currentTime = GetTime();
+    float timeSinceLastMove = (float)(currentTime - r->last_mouse_move_time);
     
     if (timeSinceLastMove < SCROLLBAR_HIDE_DELAY) {
         r->scrollbar_opacity = Clamp(
@@ -912,28 +1072,118 @@ void Rocks_ProcessEventsRaylib(Rocks* rocks) {
         );
     }
 
+    // Keep drawing while the scrollbar fades, and wake up when it should hide
+    if (timeSinceLastMove < SCROLLBAR_HIDE_DELAY) {
+        if (r->scrollbar_opacity < 1.0f) {
+            Rocks_RequestFrame();
+        } else {
+            Rocks_RequestFrameIn(SCROLLBAR_HIDE_DELAY - timeSinceLastMove);
+        }
+    } else if (r->scrollbar_opacity > 0.0f) {
+        Rocks_RequestFrame();
+    }
+
     // Update scroll physics
     UpdateScrollState(r);
 }
 
-void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands) {
-    Rocks_RaylibRenderer* r = rocks->renderer_data;
-    if (!r) return;
-    
-    r->rocks->current_frame_commands = commands;
-
-    BeginDrawing();
-    ClearBackground(BLACK);
-
-    r->scroll_container_count = 0;
-    r->pointer_elements_count = 0;
+// Draws the commands that reach `damage` (in pixels) clipped to it, or all
+// of them when it is NULL. Prepared layers stand in for their commands.
+static void DrawCommandsRaylib(Rocks_RaylibRenderer* r, Clay_RenderCommandArray commands, const Rectangle* damage, bool use_layers) {
+    Clay_BoundingBox area = {0};
+    if (damage) {
+        area = (Clay_BoundingBox){
+            damage->x / r->scale_factor,
+            damage->y / r->scale_factor,
+            damage->width / r->scale_factor,
+            damage->height / r->scale_factor
+        };
+        BeginScissorMode(damage->x, damage->y, damage->width, damage->height);
+    }
 
-    for (uint32_t i = 0; i < commands.length; i++) {
+    int next_layer = 0;
+    for (int32_t i = 0; i < commands.length; i++) {
         Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, i);
         if (!cmd) continue;
 
+        if (use_layers && next_layer < r->layer_draw_count && r->layer_draws[next_layer].span.first == i) {
+            Rocks_RaylibLayerDraw* draw = &r->layer_draws[next_layer++];
+            i += draw->span.count - 1;
+            if (damage && !Rocks_DamageOverlaps(draw->span.bounds, area)) continue;
+
+            // Layer pixels are premultiplied; render textures are stored upside down
+            Rocks_FlushShapeBatchRaylib(&r->shapes);
+            BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+            DrawTextureRec(
+                draw->layer->target.texture,
+                (Rectangle){ 0, 0, draw->rect.width, -draw->rect.height },
+                (Vector2){ draw->rect.x, draw->rect.y },
+                WHITE
+            );
+            EndBlendMode();
+            continue;
+        }
+
+        // Scissors always apply so nested clips stay balanced
+        if (damage &&
+            cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START &&
+            cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_END &&
+            !Rocks_DamageOverlaps(Rocks_GetCommandDamageBounds(cmd), area)) {
+            continue;
+        }
+
+        // Rectangles and borders queue in the shape batch; anything else
+        // draws through raylib or changes the scissor, so flush first
+        if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_RECTANGLE &&
+            cmd->commandType != CLAY_RENDER_COMMAND_TYPE_BORDER) {
+            Rocks_FlushShapeBatchRaylib(&r->shapes);
+        }
+
         switch (cmd->commandType) {
             case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+                if (r->shapes.ready) {
+                    Clay_RectangleRenderData rectData = cmd->renderData.rectangle;
+                    RocksCustomData* customData = (RocksCustomData*)cmd->userData;
+                    float scale = r->scale_factor;
+
+                    Rocks_ShapeStyle style = {
+                        .fill = {
+                            rectData.backgroundColor.r,
+                            rectData.backgroundColor.g,
+                            rectData.backgroundColor.b,
+                            rectData.backgroundColor.a
+                        },
+                        .radius = {
+                            rectData.cornerRadius.topLeft * scale,
+                            rectData.cornerRadius.topRight * scale,
+                            rectData.cornerRadius.bottomLeft * scale,
+                            rectData.cornerRadius.bottomRight * scale
+                        }
+                    };
+
+                    if (customData && customData->shadowEnabled) {
+                        style.shadow_color = (Color){
+                            customData->shadowColor.r,
+                            customData->shadowColor.g,
+                            customData->shadowColor.b,
+                            customData->shadowColor.a
+                        };
+                        style.shadow_offset = (Vector2){
+                            customData->shadowOffset.x * scale,
+                            customData->shadowOffset.y * scale
+                        };
+                        style.shadow_blur = customData->shadowBlurRadius * scale;
+                        style.shadow_spread = customData->shadowSpread * scale;
+                    }
+
+                    Rocks_DrawShapeRaylib(&r->shapes, (Rectangle){
+                        cmd->boundingBox.x * scale,
+                        cmd->boundingBox.y * scale,
+                        cmd->boundingBox.width * scale,
+                        cmd->boundingBox.height * scale
+                    }, &style);
+                    break;
+                }
 
                 Color color = {
                     cmd->renderData.rectangle.backgroundColor.r,
@@ -965,18 +1215,26 @@ void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands) {
             case CLAY_RENDER_COMMAND_TYPE_TEXT: {
                 Clay_TextRenderData textData = cmd->renderData.text;
                 
-                if (!textData.stringContents.chars || textData.stringContents.length == 0 || 
-                    textData.fontId >= 32 || !r->fonts[textData.fontId].font.baseSize) {
+                if (!textData.stringContents.chars || textData.stringContents.length == 0) {
                     continue;
                 }
 
-                char* buffer = malloc(textData.stringContents.length + 1);
+                Rocks_RaylibFontVariant* variant = GetFontVariantRaylib(r, textData.fontId, textData.fontSize);
+                if (!variant) {
+                    continue;
+                }
+
+                const char* buffer = TerminateTextRaylib(&r->draw_buffer, &r->draw_buffer_size, textData.stringContents);
                 if (!buffer) continue;
 
-                memcpy(buffer, textData.stringContents.chars, textData.stringContents.length);
-                buffer[textData.stringContents.length] = '\0';
+                Rocks_RaylibFont* entry = &r->fonts[textData.fontId];
+                Font font = variant->font;
+                float fontSize = (float)font.baseSize;
+                if (entry->sdf) {
+                    fontSize = (textData.fontSize > 0 ? textData.fontSize : entry->size) * r->scale_factor;
+                    BeginShaderMode(r->sdf_shader);
+                }
 
-                Font font = r->fonts[textData.fontId].font;
                 Color textColor = {
                     textData.textColor.r,
                     textData.textColor.g,
@@ -991,17 +1249,50 @@ void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands) {
                         cmd->boundingBox.x * r->scale_factor,
                         cmd->boundingBox.y * r->scale_factor
                     },
-                    (float)font.baseSize,
+                    fontSize,
                     0,
                     textColor
                 );
 
-                free(buffer);
+                if (entry->sdf) {
+                    EndShaderMode();
+                }
                 break;
             }
 
             case CLAY_RENDER_COMMAND_TYPE_BORDER: {
                 Clay_BorderRenderData borderData = cmd->renderData.border;
+
+                if (r->shapes.ready) {
+                    float scale = r->scale_factor;
+                    Rocks_ShapeStyle style = {
+                        .radius = {
+                            borderData.cornerRadius.topLeft * scale,
+                            borderData.cornerRadius.topRight * scale,
+                            borderData.cornerRadius.bottomLeft * scale,
+                            borderData.cornerRadius.bottomRight * scale
+                        },
+                        .border_color = {
+                            borderData.color.r,
+                            borderData.color.g,
+                            borderData.color.b,
+                            borderData.color.a
+                        },
+                        .border_top = borderData.width.top * scale,
+                        .border_right = borderData.width.right * scale,
+                        .border_bottom = borderData.width.bottom * scale,
+                        .border_left = borderData.width.left * scale
+                    };
+
+                    Rocks_DrawShapeRaylib(&r->shapes, (Rectangle){
+                        cmd->boundingBox.x * scale,
+                        cmd->boundingBox.y * scale,
+                        cmd->boundingBox.width * scale,
+                        cmd->boundingBox.height * scale
+                    }, &style);
+                    break;
+                }
+
                 Rectangle rect = {
                     cmd->boundingBox.x * r->scale_factor,
                     cmd->boundingBox.y * r->scale_factor,
@@ -1021,47 +1312,37 @@ void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands) {
                 break;
             }
             case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
-                // Only track scroll container if it's not under a modal
-                if (r->scroll_container_count < MAX_SCROLL_CONTAINERS) {
-                    bool shouldTrack = true;
-                    if (GActiveModal) {
-                        Vector2 containerPos = {
-                            cmd->boundingBox.x,
-                            cmd->boundingBox.y
-                        };
-                        shouldTrack = IsInsideModal(containerPos);
-                    }
-
-                    if (shouldTrack) {
-                        r->scroll_containers[r->scroll_container_count].elementId = cmd->id;
-                        r->scroll_containers[r->scroll_container_count].openThisFrame = true;
-                        r->scroll_container_count++;
+                Clay_ElementId elementId = { .id = cmd->id };
+                Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
 
-                        Clay_ElementId elementId = { .id = cmd->id };
-                        Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
-                        
-                        if (scrollData.found) {
-                            if (scrollData.config.vertical) {
-                                RenderScrollbar(r, cmd->boundingBox, true, &scrollData.config, elementId);
-                            }
-                            if (scrollData.config.horizontal) {
-                                RenderScrollbar(r, cmd->boundingBox, false, &scrollData.config, elementId);
-                            }
-                        }
+                if (scrollData.found) {
+                    if (scrollData.config.vertical) {
+                        RenderScrollbar(r, cmd->boundingBox, true, &scrollData.config, elementId);
+                    }
+                    if (scrollData.config.horizontal) {
+                        RenderScrollbar(r, cmd->boundingBox, false, &scrollData.config, elementId);
                     }
                 }
 
-                BeginScissorMode(
+                Rectangle clip = {
                     cmd->boundingBox.x * r->scale_factor,
                     cmd->boundingBox.y * r->scale_factor,
                     cmd->boundingBox.width * r->scale_factor,
                     cmd->boundingBox.height * r->scale_factor
-                );
+                };
+                if (damage) {
+                    clip = GetCollisionRec(clip, *damage);
+                }
+                BeginScissorMode(clip.x, clip.y, clip.width, clip.height);
                 break;
             }
 
             case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END: {
-                EndScissorMode();
+                if (damage) {
+                    BeginScissorMode(damage->x, damage->y, damage->width, damage->height);
+                } else {
+                    EndScissorMode();
+                }
                 break;
             }
 
@@ -1100,6 +1381,334 @@ void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands) {
         }
     }
 
+    Rocks_FlushShapeBatchRaylib(&r->shapes);
+}
+
+// Returns the layer for `id` with a render texture of the given size, and
+// whether nothing in it can be reused. Scroll layers pass a zero hash.
+static Rocks_RaylibLayer* AcquireLayerRaylib(Rocks_RaylibRenderer* r, uint32_t id, bool scrolls, uint64_t hash, int width, int height, bool* stale) {
+    if (width <= 0 || height <= 0) return NULL;
+
+    Rocks_RaylibLayer* layer = Rocks_AcquireLayerEntry(&r->layer_table, id, scrolls);
+    if (!layer) return NULL;
+
+    if (layer->target.id && (layer->target.texture.width != width || layer->target.texture.height != height)) {
+        UnloadRenderTexture(layer->target);
+        layer->target = (RenderTexture2D){0};
+        if (layer->spare.id) {
+            UnloadRenderTexture(layer->spare);
+            layer->spare = (RenderTexture2D){0};
+        }
+    }
+    if (!layer->target.id) {
+        layer->target = LoadRenderTexture(width, height);
+        if (!layer->target.id) {
+            printf("Failed to create layer texture\n");
+            return NULL;
+        }
+        layer->slot.dirty = true;
+    }
+
+    *stale = Rocks_TakeLayerStale(&layer->slot, hash);
+    return layer;
+}
+
+// Copies a span's commands into the layer command buffer, moved by
+// (-dx, -dy). Empty when the buffer cannot grow.
+static Clay_RenderCommandArray CopyLayerCommandsRaylib(Rocks_RaylibRenderer* r, Clay_RenderCommandArray commands, const Rocks_LayerSpan* span, float dx, float dy) {
+    int32_t count = span->count;
+    if (count > r->layer_commands_capacity) {
+        Clay_RenderCommand* layer_commands = realloc(r->layer_commands, count * sizeof(Clay_RenderCommand));
+        if (!layer_commands) return (Clay_RenderCommandArray){0};
+        r->layer_commands = layer_commands;
+        r->layer_commands_capacity = count;
+    }
+
+    for (int32_t i = 0; i < count; i++) {
+        r->layer_commands[i] = *Clay_RenderCommandArray_Get(&commands, span->first + i);
+        r->layer_commands[i].boundingBox.x -= dx;
+        r->layer_commands[i].boundingBox.y -= dy;
+    }
+    return (Clay_RenderCommandArray){ .capacity = count, .length = count, .internalArray = r->layer_commands };
+}
+
+// Blends draws into a layer target so it holds premultiplied color and
+// coverage alpha. raylib's BLEND_ALPHA would scale the stored alpha by
+// itself, lightening translucent edges once composited.
+static void BeginLayerBlendRaylib(void) {
+    rlSetBlendFactorsSeparate(
+        RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA,
+        RL_ONE, RL_ONE_MINUS_SRC_ALPHA,
+        RL_FUNC_ADD, RL_FUNC_ADD
+    );
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+// Redraws a layer's commands into its texture, shifted so the layer's
+// top-left pixel lands on the texture origin
+static bool DrawLayerRaylib(Rocks_RaylibRenderer* r, Clay_RenderCommandArray commands, Rocks_RaylibLayerDraw* draw) {
+    Clay_RenderCommandArray layer_commands = CopyLayerCommandsRaylib(
+        r, commands, &draw->span,
+        draw->rect.x / r->scale_factor,
+        draw->rect.y / r->scale_factor
+    );
+    if (!layer_commands.length) return false;
+
+    BeginTextureMode(draw->layer->target);
+    ClearBackground(BLANK);
+    BeginLayerBlendRaylib();
+    DrawCommandsRaylib(r, layer_commands, NULL, false);
+    EndBlendMode();
+    EndScissorMode();
+    EndTextureMode();
+    return true;
+}
+
+// Moves a scroll layer's pixels by whole pixels through its spare target,
+// leaving the uncovered strips undefined
+static bool ShiftScrollLayerRaylib(Rocks_RaylibLayer* layer, int dx, int dy) {
+    int width = layer->target.texture.width;
+    int height = layer->target.texture.height;
+    if (!layer->spare.id) {
+        layer->spare = LoadRenderTexture(width, height);
+        if (!layer->spare.id) {
+            printf("Failed to create layer texture\n");
+            return false;
+        }
+    }
+
+    BeginTextureMode(layer->spare);
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawTextureRec(
+        layer->target.texture,
+        (Rectangle){ 0, 0, (float)width, (float)-height },
+        (Vector2){ (float)dx, (float)dy },
+        WHITE
+    );
+    EndBlendMode();
+    EndTextureMode();
+
+    RenderTexture2D swap = layer->target;
+    layer->target = layer->spare;
+    layer->spare = swap;
+    return true;
+}
+
+// Brings a scroll container's texture up to date. Last frame's pixels are
+// shifted by the distance scrolled, so only the strips this uncovers and
+// children that changed are drawn again.
+static bool DrawScrollLayerRaylib(Rocks_RaylibRenderer* r, Clay_RenderCommandArray commands, Rocks_RaylibLayerDraw* draw) {
+    bool stale = false;
+    Rocks_RaylibLayer* layer = AcquireLayerRaylib(r, draw->span.id, true, 0,
+                                                  (int)draw->rect.width, (int)draw->rect.height, &stale);
+    if (!layer) return false;
+    draw->layer = layer;
+
+    Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData((Clay_ElementId){ .id = draw->span.id });
+    Clay_Vector2 scroll = scrollData.found ? *scrollData.scrollPosition : (Clay_Vector2){0};
+
+    // Content is drawn as if scrolled by whole pixels, so shifted pixels
+    // line up with the strips drawn next to them
+    Clay_Vector2 offset = {
+        roundf(scroll.x * r->scale_factor),
+        roundf(scroll.y * r->scale_factor)
+    };
+    int dx = (int)(offset.x - layer->offset.x);
+    int dy = (int)(offset.y - layer->offset.y);
+
+    layer->damage.extra_hash = HashScrollbarStateRaylib;
+    layer->damage.user_data = r;
+    if (stale || abs(dx) >= layer->target.texture.width || abs(dy) >= layer->target.texture.height) {
+        Rocks_InvalidateDamage(&layer->damage);
+    } else if (dx || dy) {
+        if (!ShiftScrollLayerRaylib(layer, dx, dy)) {
+            layer->slot.dirty = true;
+            return false;
+        }
+        Rocks_ShiftDamage(&layer->damage, (Clay_Vector2){ dx / r->scale_factor, dy / r->scale_factor });
+    }
+    layer->offset = offset;
+
+    Clay_RenderCommandArray layer_commands = CopyLayerCommandsRaylib(
+        r, commands, &draw->span,
+        draw->rect.x / r->scale_factor + scroll.x - offset.x / r->scale_factor,
+        draw->rect.y / r->scale_factor + scroll.y - offset.y / r->scale_factor
+    );
+    if (!layer_commands.length) {
+        layer->slot.dirty = true;
+        return false;
+    }
+
+    Rocks_ComputeDamage(&layer->damage, layer_commands, (Clay_Dimensions){
+        layer->target.texture.width / r->scale_factor,
+        layer->target.texture.height / r->scale_factor
+    });
+
+    BeginTextureMode(layer->target);
+    BeginLayerBlendRaylib();
+    for (int i = 0; i < layer->damage.rect_count; i++) {
+        Clay_BoundingBox rect = layer->damage.rects[i];
+        float x0 = floorf(rect.x * r->scale_factor);
+        float y0 = floorf(rect.y * r->scale_factor);
+        float x1 = ceilf((rect.x + rect.width) * r->scale_factor);
+        float y1 = ceilf((rect.y + rect.height) * r->scale_factor);
+        Rectangle clip = { x0, y0, x1 - x0, y1 - y0 };
+
+        // Clearing honors the scissor, leaving the rest of the layer intact
+        BeginScissorMode(clip.x, clip.y, clip.width, clip.height);
+        ClearBackground(BLANK);
+        DrawCommandsRaylib(r, layer_commands, &clip, false);
+    }
+    EndBlendMode();
+    EndScissorMode();
+    EndTextureMode();
+    return true;
+}
+
+// Finds the cached layers and scroll containers in this frame and brings
+// their textures up to date, before any pass targets the backbuffer
+static void PrepareLayersRaylib(Rocks_RaylibRenderer* r, Clay_RenderCommandArray commands) {
+    r->layer_draw_count = 0;
+    Rocks_BeginLayerTableFrame(&r->layer_table);
+
+    for (int32_t i = 0; i < commands.length && r->layer_draw_count < ROCKS_MAX_CACHED_LAYERS; i++) {
+        Rocks_RaylibLayerDraw draw = {0};
+
+        if (Rocks_FindScrollSpan(&commands, i, &draw.span)) {
+            // Same truncation the scissor gets, so the texture fills the clip
+            draw.rect = (Rectangle){
+                (int)(draw.span.bounds.x * r->scale_factor),
+                (int)(draw.span.bounds.y * r->scale_factor),
+                (int)(draw.span.bounds.width * r->scale_factor),
+                (int)(draw.span.bounds.height * r->scale_factor)
+            };
+
+            if (DrawScrollLayerRaylib(r, commands, &draw)) {
+                r->layer_draws[r->layer_draw_count++] = draw;
+                i = draw.span.first + draw.span.count - 1;
+            }
+            continue;
+        }
+
+        if (!Rocks_FindLayerSpan(&commands, i, HashScrollbarStateRaylib, r, &draw.span)) continue;
+
+        float x0 = floorf(draw.span.bounds.x * r->scale_factor);
+        float y0 = floorf(draw.span.bounds.y * r->scale_factor);
+        float x1 = ceilf((draw.span.bounds.x + draw.span.bounds.width) * r->scale_factor);
+        float y1 = ceilf((draw.span.bounds.y + draw.span.bounds.height) * r->scale_factor);
+        draw.rect = (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+
+        bool stale = false;
+        draw.layer = AcquireLayerRaylib(r, draw.span.id, false, draw.span.hash,
+                                        (int)draw.rect.width, (int)draw.rect.height, &stale);
+        if (!draw.layer) continue;
+
+        if (stale && !DrawLayerRaylib(r, commands, &draw)) {
+            draw.layer->slot.dirty = true;
+            continue;
+        }
+
+        r->layer_draws[r->layer_draw_count++] = draw;
+        i += draw.span.count - 1;
+    }
+}
+
+// Recreates the backbuffer to match the screen, falling back to drawing
+// straight to the window for good if render textures are unavailable
+static bool EnsureBackbufferRaylib(Rocks_RaylibRenderer* r, int width, int height) {
+    if (r->backbuffer_failed || width <= 0 || height <= 0) return false;
+    if (r->backbuffer.id && r->backbuffer.texture.width == width && r->backbuffer.texture.height == height) {
+        return true;
+    }
+
+    if (r->backbuffer.id) {
+        UnloadRenderTexture(r->backbuffer);
+    }
+
+    r->backbuffer = LoadRenderTexture(width, height);
+    if (!r->backbuffer.id) {
+        printf("Failed to create backbuffer, redrawing every frame\n");
+        r->backbuffer_failed = true;
+        return false;
+    }
+
+    Rocks_InvalidateDamage(&r->damage);
+    return true;
+}
+
+void Rocks_RenderRaylib(Rocks* rocks, Clay_RenderCommandArray commands) {
+    Rocks_RaylibRenderer* r = rocks->renderer_data;
+    if (!r) return;
+    
+    r->rocks->current_frame_commands = commands;
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+
+    ROCKS_PROFILE_BEGIN(track);
+    // Both look at every command, while drawing skips the ones outside
+    // the damaged areas
+    Clay_Dimensions viewport = {width / r->scale_factor, height / r->scale_factor};
+    Rocks_BuildScrollRegistry(&r->scroll_registry, commands, viewport);
+    Rocks_BuildHitIndex(&r->hit_index, commands, viewport);
+    ROCKS_PROFILE_END(track);
+
+    if (EnsureBackbufferRaylib(r, width, height)) {
+        ROCKS_PROFILE_BEGIN(damage);
+        Rocks_ComputeDamage(&r->damage, commands, (Clay_Dimensions){
+            width / r->scale_factor,
+            height / r->scale_factor
+        });
+        ROCKS_PROFILE_END(damage);
+
+        ROCKS_PROFILE_BEGIN(layers);
+        PrepareLayersRaylib(r, commands);
+        ROCKS_PROFILE_END(layers);
+
+        ROCKS_PROFILE_BEGIN(draw);
+        BeginTextureMode(r->backbuffer);
+        for (int i = 0; i < r->damage.rect_count; i++) {
+            Clay_BoundingBox rect = r->damage.rects[i];
+            float x0 = floorf(rect.x * r->scale_factor);
+            float y0 = floorf(rect.y * r->scale_factor);
+            float x1 = ceilf((rect.x + rect.width) * r->scale_factor);
+            float y1 = ceilf((rect.y + rect.height) * r->scale_factor);
+            Rectangle clip = { x0, y0, x1 - x0, y1 - y0 };
+
+            BeginScissorMode(clip.x, clip.y, clip.width, clip.height);
+            DrawRectangleRec(clip, BLACK);
+            DrawCommandsRaylib(r, commands, &clip, true);
+        }
+        EndScissorMode();
+        EndTextureMode();
+
+        BeginDrawing();
+
+        // Blended draws leave the backbuffer alpha below one, so it is
+        // copied as is; render textures are stored upside down
+        rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM);
+        DrawTextureRec(
+            r->backbuffer.texture,
+            (Rectangle){ 0, 0, (float)width, -(float)height },
+            (Vector2){ 0, 0 },
+            WHITE
+        );
+        EndBlendMode();
+        ROCKS_PROFILE_END(draw);
+    } else {
+        ROCKS_PROFILE_BEGIN(draw);
+        BeginDrawing();
+        ClearBackground(BLACK);
+        DrawCommandsRaylib(r, commands, NULL, false);
+        EndScissorMode();
+        ROCKS_PROFILE_END(draw);
+    }
+
     UpdateCursor(r);
+
+    // EndDrawing also polls input and, in idle mode, waits for it
+    ROCKS_PROFILE_BEGIN(present);
     EndDrawing();
+    ROCKS_PROFILE_END(present);
 }
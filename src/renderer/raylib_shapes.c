@@ -0,0 +1,320 @@
+#include "renderer/raylib_shapes.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(PLATFORM_ANDROID) || defined(PLATFORM_WEB)
+#define ROCKS_SHAPE_VERTEX_HEADER \
+    "#version 100\n" \
+    "#define IN attribute\n" \
+    "#define OUT varying\n"
+#define ROCKS_SHAPE_FRAGMENT_HEADER \
+    "#version 100\n" \
+    "#ifdef GL_FRAGMENT_PRECISION_HIGH\n" \
+    "precision highp float;\n" \
+    "#else\n" \
+    "precision mediump float;\n" \
+    "#endif\n" \
+    "#define IN varying\n" \
+    "#define FRAG_COLOR gl_FragColor\n"
+#else
+#define ROCKS_SHAPE_VERTEX_HEADER \
+    "#version 330\n" \
+    "#define IN in\n" \
+    "#define OUT out\n"
+#define ROCKS_SHAPE_FRAGMENT_HEADER \
+    "#version 330\n" \
+    "#define IN in\n" \
+    "out vec4 finalColor;\n" \
+    "#define FRAG_COLOR finalColor\n"
+#endif
+
+static const char* ROCKS_SHAPE_VERTEX_SHADER = ROCKS_SHAPE_VERTEX_HEADER
+    "IN vec2 vertexPosition;\n"
+    "IN vec4 vertexRect;\n"
+    "IN vec4 vertexRadii;\n"
+    "IN vec4 vertexBorders;\n"
+    "IN vec4 vertexShadow;\n"
+    "IN vec4 vertexFill;\n"
+    "IN vec4 vertexBorderColor;\n"
+    "IN vec4 vertexShadowColor;\n"
+    "uniform mat4 mvp;\n"
+    "OUT vec4 fragRect;\n"
+    "OUT vec4 fragRadii;\n"
+    "OUT vec4 fragBorders;\n"
+    "OUT vec4 fragShadow;\n"
+    "OUT vec4 fragFill;\n"
+    "OUT vec4 fragBorderColor;\n"
+    "OUT vec4 fragShadowColor;\n"
+    "void main() {\n"
+    "    fragRect = vertexRect;\n"
+    "    fragRadii = vertexRadii;\n"
+    "    fragBorders = vertexBorders;\n"
+    "    fragShadow = vertexShadow;\n"
+    "    fragFill = vertexFill;\n"
+    "    fragBorderColor = vertexBorderColor;\n"
+    "    fragShadowColor = vertexShadowColor;\n"
+    "    gl_Position = mvp * vec4(vertexPosition, 0.0, 1.0);\n"
+    "}\n";
+
+// Rounded box distance and blurred box shadow after Inigo Quilez and
+// Evan Wallace. Coordinates are pixels from the shape center, y down.
+static const char* ROCKS_SHAPE_FRAGMENT_SHADER = ROCKS_SHAPE_FRAGMENT_HEADER
+    "IN vec4 fragRect;\n"
+    "IN vec4 fragRadii;\n"
+    "IN vec4 fragBorders;\n"
+    "IN vec4 fragShadow;\n"
+    "IN vec4 fragFill;\n"
+    "IN vec4 fragBorderColor;\n"
+    "IN vec4 fragShadowColor;\n"
+    "float CornerRadius(vec2 p, vec4 radii) {\n"
+    "    return p.x > 0.0 ? (p.y > 0.0 ? radii.z : radii.y) : (p.y > 0.0 ? radii.w : radii.x);\n"
+    "}\n"
+    "float RoundedBox(vec2 p, vec2 halfSize, vec4 radii) {\n"
+    "    float r = CornerRadius(p, radii);\n"
+    "    vec2 q = abs(p) - halfSize + r;\n"
+    "    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - r;\n"
+    "}\n"
+    "vec2 Erf(vec2 x) {\n"
+    "    vec2 s = sign(x);\n"
+    "    vec2 a = abs(x);\n"
+    "    x = 1.0 + (0.278393 + (0.230389 + 0.078108 * (a * a)) * a) * a;\n"
+    "    x *= x;\n"
+    "    return s - s / (x * x);\n"
+    "}\n"
+    "float Gaussian(float x, float sigma) {\n"
+    "    return exp(-(x * x) / (2.0 * sigma * sigma)) / (2.5066283 * sigma);\n"
+    "}\n"
+    "float BlurredRow(float x, float y, float sigma, float corner, vec2 halfSize) {\n"
+    "    float delta = min(halfSize.y - corner - abs(y), 0.0);\n"
+    "    float curved = halfSize.x - corner + sqrt(max(0.0, corner * corner - delta * delta));\n"
+    "    vec2 integral = 0.5 + 0.5 * Erf((x + vec2(-curved, curved)) * (0.7071068 / sigma));\n"
+    "    return integral.y - integral.x;\n"
+    "}\n"
+    "float BlurredBox(vec2 p, vec2 halfSize, float sigma, float corner) {\n"
+    "    float low = p.y - halfSize.y;\n"
+    "    float high = p.y + halfSize.y;\n"
+    "    float start = clamp(-3.0 * sigma, low, high);\n"
+    "    float end = clamp(3.0 * sigma, low, high);\n"
+    "    float stride = (end - start) / 4.0;\n"
+    "    float y = start + stride * 0.5;\n"
+    "    float value = 0.0;\n"
+    "    for (int i = 0; i < 4; i++) {\n"
+    "        value += BlurredRow(p.x, p.y - y, sigma, corner, halfSize) * Gaussian(y, sigma) * stride;\n"
+    "        y += stride;\n"
+    "    }\n"
+    "    return value;\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 p = fragRect.xy;\n"
+    "    vec2 halfSize = fragRect.zw;\n"
+    "    float shape = clamp(0.5 - RoundedBox(p, halfSize, fragRadii), 0.0, 1.0);\n"
+    "    float border = 0.0;\n"
+    "    if (any(greaterThan(fragBorders, vec4(0.0)))) {\n"
+    "        vec2 innerOffset = vec2(fragBorders.w - fragBorders.y, fragBorders.x - fragBorders.z) * 0.5;\n"
+    "        vec2 innerHalf = max(halfSize - vec2(fragBorders.w + fragBorders.y, fragBorders.x + fragBorders.z) * 0.5, vec2(0.0));\n"
+    "        vec4 innerRadii = max(fragRadii - vec4(\n"
+    "            max(fragBorders.x, fragBorders.w), max(fragBorders.x, fragBorders.y),\n"
+    "            max(fragBorders.z, fragBorders.y), max(fragBorders.z, fragBorders.w)), vec4(0.0));\n"
+    "        border = shape * clamp(0.5 + RoundedBox(p - innerOffset, innerHalf, innerRadii), 0.0, 1.0);\n"
+    "    }\n"
+    "    float shadow = 0.0;\n"
+    "    if (fragShadowColor.a > 0.0) {\n"
+    "        vec2 sp = p - fragShadow.xy;\n"
+    "        vec2 sh = max(halfSize + fragShadow.w, vec2(0.0));\n"
+    "        vec4 sr = max(fragRadii + fragShadow.w, vec4(0.0));\n"
+    "        if (fragShadow.z < 0.5) {\n"
+    "            shadow = clamp(0.5 - RoundedBox(sp, sh, sr), 0.0, 1.0);\n"
+    "        } else {\n"
+    "            shadow = BlurredBox(sp, sh, fragShadow.z, min(CornerRadius(sp, sr), min(sh.x, sh.y)));\n"
+    "        }\n"
+    "        shadow *= 1.0 - shape;\n"
+    "    }\n"
+    "    vec4 color = vec4(fragShadowColor.rgb, 1.0) * fragShadowColor.a * shadow;\n"
+    "    vec4 fill = vec4(fragFill.rgb, 1.0) * fragFill.a * shape;\n"
+    "    color = fill + color * (1.0 - fill.a);\n"
+    "    vec4 edge = vec4(fragBorderColor.rgb, 1.0) * fragBorderColor.a * border;\n"
+    "    color = edge + color * (1.0 - edge.a);\n"
+    "    if (color.a <= 0.0) discard;\n"
+    "    FRAG_COLOR = vec4(color.rgb / color.a, color.a);\n"
+    "}\n";
+
+static const char* ROCKS_SHAPE_ATTRIBUTES[8] = {
+    "vertexPosition", "vertexRect", "vertexRadii", "vertexBorders",
+    "vertexShadow", "vertexFill", "vertexBorderColor", "vertexShadowColor"
+};
+
+static void SetShapeAttributes(const Rocks_RaylibShapeBatch* batch) {
+    static const struct { int size; int type; bool normalized; int offset; } layout[8] = {
+        { 2, RL_FLOAT, false, offsetof(Rocks_ShapeVertex, position) },
+        { 4, RL_FLOAT, false, offsetof(Rocks_ShapeVertex, rect) },
+        { 4, RL_FLOAT, false, offsetof(Rocks_ShapeVertex, radii) },
+        { 4, RL_FLOAT, false, offsetof(Rocks_ShapeVertex, borders) },
+        { 4, RL_FLOAT, false, offsetof(Rocks_ShapeVertex, shadow) },
+        { 4, RL_UNSIGNED_BYTE, true, offsetof(Rocks_ShapeVertex, fill) },
+        { 4, RL_UNSIGNED_BYTE, true, offsetof(Rocks_ShapeVertex, border_color) },
+        { 4, RL_UNSIGNED_BYTE, true, offsetof(Rocks_ShapeVertex, shadow_color) },
+    };
+
+    for (int i = 0; i < 8; i++) {
+        int location = batch->attrib_locations[i];
+        if (location < 0) continue;
+        rlEnableVertexAttribute(location);
+        rlSetVertexAttribute(location, layout[i].size, layout[i].type, layout[i].normalized,
+                             sizeof(Rocks_ShapeVertex), layout[i].offset);
+    }
+}
+
+bool Rocks_InitShapeBatchRaylib(Rocks_RaylibShapeBatch* batch) {
+    *batch = (Rocks_RaylibShapeBatch){0};
+
+    batch->shader = LoadShaderFromMemory(ROCKS_SHAPE_VERTEX_SHADER, ROCKS_SHAPE_FRAGMENT_SHADER);
+    if (batch->shader.id == 0 || batch->shader.id == rlGetShaderIdDefault()) {
+        printf("WARNING: Shape shader failed to compile, using raylib shapes\n");
+        return false;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        batch->attrib_locations[i] = GetShaderLocationAttrib(batch->shader, ROCKS_SHAPE_ATTRIBUTES[i]);
+    }
+    batch->mvp_location = GetShaderLocation(batch->shader, "mvp");
+
+    const int vertex_count = ROCKS_SHAPE_BATCH_QUADS * 4;
+    const int index_count = ROCKS_SHAPE_BATCH_QUADS * 6;
+    batch->vertices = calloc(vertex_count, sizeof(Rocks_ShapeVertex));
+    unsigned short* indices = malloc(index_count * sizeof(unsigned short));
+    if (!batch->vertices || !indices) {
+        free(batch->vertices);
+        free(indices);
+        UnloadShader(batch->shader);
+        *batch = (Rocks_RaylibShapeBatch){0};
+        return false;
+    }
+
+    for (int i = 0; i < ROCKS_SHAPE_BATCH_QUADS; i++) {
+        unsigned short base = (unsigned short)(i * 4);
+        unsigned short* quad = indices + i * 6;
+        quad[0] = base;
+        quad[1] = base + 1;
+        quad[2] = base + 2;
+        quad[3] = base;
+        quad[4] = base + 2;
+        quad[5] = base + 3;
+    }
+
+    // Without VAO support the attributes are bound again on every flush
+    batch->vao = rlLoadVertexArray();
+    rlEnableVertexArray(batch->vao);
+    batch->vbo = rlLoadVertexBuffer(NULL, vertex_count * sizeof(Rocks_ShapeVertex), true);
+    SetShapeAttributes(batch);
+    batch->ebo = rlLoadVertexBufferElement(indices, index_count * sizeof(unsigned short), false);
+    rlDisableVertexArray();
+
+    free(indices);
+    batch->ready = true;
+    return true;
+}
+
+void Rocks_CleanupShapeBatchRaylib(Rocks_RaylibShapeBatch* batch) {
+    if (!batch->ready) return;
+
+    rlUnloadVertexBuffer(batch->vbo);
+    rlUnloadVertexBuffer(batch->ebo);
+    rlUnloadVertexArray(batch->vao);
+    UnloadShader(batch->shader);
+    free(batch->vertices);
+    *batch = (Rocks_RaylibShapeBatch){0};
+}
+
+void Rocks_FlushShapeBatchRaylib(Rocks_RaylibShapeBatch* batch) {
+    if (!batch->ready || batch->quad_count == 0) return;
+
+    // raylib's own pending geometry was submitted earlier in paint order
+    rlDrawRenderBatchActive();
+
+    rlEnableShader(batch->shader.id);
+    rlSetUniformMatrix(batch->mvp_location, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    rlUpdateVertexBuffer(batch->vbo, batch->vertices, batch->quad_count * 4 * sizeof(Rocks_ShapeVertex), 0);
+
+    bool has_vao = rlEnableVertexArray(batch->vao);
+    if (!has_vao) {
+        rlEnableVertexBuffer(batch->vbo);
+        SetShapeAttributes(batch);
+        rlEnableVertexBufferElement(batch->ebo);
+    }
+
+    rlDrawVertexArrayElements(0, batch->quad_count * 6, 0);
+
+    if (has_vao) {
+        rlDisableVertexArray();
+    } else {
+        for (int i = 0; i < 8; i++) {
+            if (batch->attrib_locations[i] >= 0) rlDisableVertexAttribute(batch->attrib_locations[i]);
+        }
+        rlDisableVertexBuffer();
+        rlDisableVertexBufferElement();
+    }
+    rlDisableShader();
+
+    batch->quad_count = 0;
+}
+
+void Rocks_DrawShapeRaylib(Rocks_RaylibShapeBatch* batch, Rectangle rect, const Rocks_ShapeStyle* style) {
+    if (!batch->ready || rect.width <= 0 || rect.height <= 0) return;
+    if (style->fill.a == 0 && style->border_color.a == 0 && style->shadow_color.a == 0) return;
+
+    if (batch->quad_count == ROCKS_SHAPE_BATCH_QUADS) {
+        Rocks_FlushShapeBatchRaylib(batch);
+    }
+
+    float half_w = rect.width / 2;
+    float half_h = rect.height / 2;
+    float max_radius = fminf(half_w, half_h);
+    float sigma = style->shadow_blur > 0 ? style->shadow_blur / 2 : 0;
+
+    // One pixel of margin for anti-aliasing, plus the shadow's reach
+    float extent_x = 1.0f;
+    float extent_y = 1.0f;
+    if (style->shadow_color.a > 0) {
+        float reach = fmaxf(style->shadow_spread, 0) + 3 * sigma + 1;
+        extent_x = fmaxf(extent_x, reach + fabsf(style->shadow_offset.x));
+        extent_y = fmaxf(extent_y, reach + fabsf(style->shadow_offset.y));
+    }
+
+    Rocks_ShapeVertex vertex = {
+        .radii = {
+            Clamp(style->radius.topLeft, 0, max_radius),
+            Clamp(style->radius.topRight, 0, max_radius),
+            Clamp(style->radius.bottomRight, 0, max_radius),
+            Clamp(style->radius.bottomLeft, 0, max_radius)
+        },
+        .borders = { style->border_top, style->border_right, style->border_bottom, style->border_left },
+        .shadow = { style->shadow_offset.x, style->shadow_offset.y, sigma, style->shadow_spread },
+        .fill = { style->fill.r, style->fill.g, style->fill.b, style->fill.a },
+        .border_color = { style->border_color.r, style->border_color.g, style->border_color.b, style->border_color.a },
+        .shadow_color = { style->shadow_color.r, style->shadow_color.g, style->shadow_color.b, style->shadow_color.a }
+    };
+
+    // Corners in index order: top-left, top-right, bottom-right, bottom-left
+    static const float corner_x[4] = { -1, 1, 1, -1 };
+    static const float corner_y[4] = { -1, -1, 1, 1 };
+
+    Rocks_ShapeVertex* out = batch->vertices + batch->quad_count * 4;
+    for (int i = 0; i < 4; i++) {
+        float local_x = corner_x[i] * (half_w + extent_x);
+        float local_y = corner_y[i] * (half_h + extent_y);
+
+        out[i] = vertex;
+        out[i].position[0] = rect.x + half_w + local_x;
+        out[i].position[1] = rect.y + half_h + local_y;
+        out[i].rect[0] = local_x;
+        out[i].rect[1] = local_y;
+        out[i].rect[2] = half_w;
+        out[i].rect[3] = half_h;
+    }
+
+    batch->quad_count++;
+}
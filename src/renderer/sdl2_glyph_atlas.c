@@ -0,0 +1,316 @@
+#include "renderer/sdl2_glyph_atlas.h"
+#include "rocks_profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROCKS_GLYPH_TABLE_INITIAL_CAPACITY 256
+#define ROCKS_GLYPH_VERTEX_INITIAL_CAPACITY (4 * 128)
+
+static uint32_t DecodeUTF8(const char* chars, int32_t length, int32_t* index) {
+    const unsigned char* s = (const unsigned char*)chars + *index;
+    int32_t remaining = length - *index;
+    uint32_t codepoint = 0xFFFD;
+    int32_t size = 1;
+
+    if (s[0] < 0x80) {
+        codepoint = s[0];
+    } else if ((s[0] & 0xE0) == 0xC0 && remaining >= 2 && (s[1] & 0xC0) == 0x80) {
+        codepoint = ((uint32_t)(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+        size = 2;
+    } else if ((s[0] & 0xF0) == 0xE0 && remaining >= 3 &&
+               (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+        codepoint = ((uint32_t)(s[0] & 0x0F) << 12) | ((uint32_t)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        size = 3;
+    } else if ((s[0] & 0xF8) == 0xF0 && remaining >= 4 &&
+               (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) {
+        codepoint = ((uint32_t)(s[0] & 0x07) << 18) | ((uint32_t)(s[1] & 0x3F) << 12) |
+                    ((uint32_t)(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+        size = 4;
+    }
+
+    *index += size;
+    return codepoint;
+}
+
+static uint32_t HashCodepoint(uint32_t codepoint) {
+    codepoint ^= codepoint >> 16;
+    codepoint *= 0x7feb352d;
+    codepoint ^= codepoint >> 15;
+    return codepoint;
+}
+
+static Rocks_SDL2Glyph* FindSlot(Rocks_SDL2Glyph* glyphs, int capacity, uint32_t codepoint) {
+    uint32_t mask = (uint32_t)capacity - 1;
+    uint32_t slot = HashCodepoint(codepoint) & mask;
+    while (glyphs[slot].codepoint != 0 && glyphs[slot].codepoint != codepoint) {
+        slot = (slot + 1) & mask;
+    }
+    return &glyphs[slot];
+}
+
+static bool GrowGlyphTable(Rocks_SDL2GlyphAtlas* atlas) {
+    int capacity = atlas->glyph_capacity * 2;
+    Rocks_SDL2Glyph* glyphs = calloc(capacity, sizeof(Rocks_SDL2Glyph));
+    if (!glyphs) return false;
+
+    for (int i = 0; i < atlas->glyph_capacity; i++) {
+        if (atlas->glyphs[i].codepoint) {
+            *FindSlot(glyphs, capacity, atlas->glyphs[i].codepoint) = atlas->glyphs[i];
+        }
+    }
+
+    free(atlas->glyphs);
+    atlas->glyphs = glyphs;
+    atlas->glyph_capacity = capacity;
+    return true;
+}
+
+static bool GrowVertices(Rocks_SDL2GlyphAtlas* atlas, int required) {
+    if (required <= atlas->vertex_capacity) return true;
+
+    int capacity = atlas->vertex_capacity ? atlas->vertex_capacity : ROCKS_GLYPH_VERTEX_INITIAL_CAPACITY;
+    while (capacity < required) capacity *= 2;
+
+    SDL_Vertex* vertices = realloc(atlas->vertices, capacity * sizeof(SDL_Vertex));
+    if (!vertices) return false;
+    atlas->vertices = vertices;
+
+    int* indices = realloc(atlas->indices, (capacity / 4) * 6 * sizeof(int));
+    if (!indices) return false;
+    atlas->indices = indices;
+
+    // The index pattern never changes, so it is written once per growth
+    for (int quad = atlas->vertex_capacity / 4; quad < capacity / 4; quad++) {
+        int base = quad * 4;
+        int* index = &indices[quad * 6];
+        index[0] = base;
+        index[1] = base + 1;
+        index[2] = base + 2;
+        index[3] = base;
+        index[4] = base + 2;
+        index[5] = base + 3;
+    }
+
+    atlas->vertex_capacity = capacity;
+    return true;
+}
+
+static void ResetAtlas(Rocks_SDL2GlyphAtlas* atlas) {
+    memset(atlas->glyphs, 0, atlas->glyph_capacity * sizeof(Rocks_SDL2Glyph));
+    atlas->glyph_count = 0;
+    atlas->pen_x = 0;
+    atlas->pen_y = 0;
+    atlas->shelf_height = 0;
+}
+
+// Returns NULL with *full set when the glyph does not fit in the atlas
+static Rocks_SDL2Glyph* AddGlyph(Rocks_SDL2GlyphAtlas* atlas, uint32_t codepoint, bool* full) {
+    *full = false;
+
+    if ((atlas->glyph_count + 1) * 4 > atlas->glyph_capacity * 3 && !GrowGlyphTable(atlas)) {
+        return NULL;
+    }
+
+    int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+    if (TTF_GlyphMetrics32(atlas->font, codepoint, &minx, &maxx, &miny, &maxy, &advance) != 0) {
+        advance = 0;
+    }
+
+    Rocks_SDL2Glyph glyph = {
+        .codepoint = codepoint,
+        .src = {0, 0, 0, 0},
+        .offset_x = minx < 0 ? minx : 0,
+        .advance = advance
+    };
+
+    SDL_Surface* surface = NULL;
+    if (maxx > minx) {
+        ROCKS_PROFILE_BEGIN(glyph_raster);
+        surface = TTF_RenderGlyph32_Blended(atlas->font, codepoint, (SDL_Color){255, 255, 255, 255});
+        ROCKS_PROFILE_END(glyph_raster);
+        if (surface && surface->format->format != SDL_PIXELFORMAT_ARGB8888) {
+            SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+            SDL_FreeSurface(surface);
+            surface = converted;
+        }
+    }
+
+    if (surface) {
+        int w = surface->w;
+        int h = surface->h;
+
+        if (atlas->pen_x + w + ROCKS_GLYPH_ATLAS_PADDING > atlas->width) {
+            atlas->pen_x = 0;
+            atlas->pen_y += atlas->shelf_height + ROCKS_GLYPH_ATLAS_PADDING;
+            atlas->shelf_height = 0;
+        }
+
+        if (w + ROCKS_GLYPH_ATLAS_PADDING > atlas->width ||
+            atlas->pen_y + h + ROCKS_GLYPH_ATLAS_PADDING > atlas->height) {
+            SDL_FreeSurface(surface);
+            *full = atlas->glyph_count > 0;
+            return NULL;
+        }
+
+        glyph.src = (SDL_Rect){
+            atlas->pen_x + ROCKS_GLYPH_ATLAS_PADDING,
+            atlas->pen_y + ROCKS_GLYPH_ATLAS_PADDING,
+            w,
+            h
+        };
+
+        SDL_LockSurface(surface);
+        SDL_UpdateTexture(atlas->texture, &glyph.src, surface->pixels, surface->pitch);
+        SDL_UnlockSurface(surface);
+        SDL_FreeSurface(surface);
+
+        atlas->pen_x += w + ROCKS_GLYPH_ATLAS_PADDING;
+        if (h > atlas->shelf_height) atlas->shelf_height = h;
+    }
+
+    Rocks_SDL2Glyph* slot = FindSlot(atlas->glyphs, atlas->glyph_capacity, codepoint);
+    *slot = glyph;
+    atlas->glyph_count++;
+    return slot;
+}
+
+static void FlushVertices(SDL_Renderer* renderer, Rocks_SDL2GlyphAtlas* atlas) {
+    if (atlas->vertex_count == 0) return;
+
+    SDL_RenderGeometry(
+        renderer,
+        atlas->texture,
+        atlas->vertices,
+        atlas->vertex_count,
+        atlas->indices,
+        (atlas->vertex_count / 4) * 6
+    );
+    atlas->vertex_count = 0;
+}
+
+static void PushQuad(Rocks_SDL2GlyphAtlas* atlas, SDL_FRect dst, SDL_Rect src, SDL_Color color) {
+    if (!GrowVertices(atlas, atlas->vertex_count + 4)) return;
+
+    float u0 = (float)src.x / atlas->width;
+    float v0 = (float)src.y / atlas->height;
+    float u1 = (float)(src.x + src.w) / atlas->width;
+    float v1 = (float)(src.y + src.h) / atlas->height;
+
+    SDL_Vertex* v = &atlas->vertices[atlas->vertex_count];
+    v[0] = (SDL_Vertex){ { dst.x, dst.y }, color, { u0, v0 } };
+    v[1] = (SDL_Vertex){ { dst.x + dst.w, dst.y }, color, { u1, v0 } };
+    v[2] = (SDL_Vertex){ { dst.x + dst.w, dst.y + dst.h }, color, { u1, v1 } };
+    v[3] = (SDL_Vertex){ { dst.x, dst.y + dst.h }, color, { u0, v1 } };
+    atlas->vertex_count += 4;
+}
+
+Rocks_SDL2GlyphAtlas* Rocks_CreateGlyphAtlasSDL2(SDL_Renderer* renderer, TTF_Font* font) {
+    if (!renderer || !font) return NULL;
+
+    Rocks_SDL2GlyphAtlas* atlas = calloc(1, sizeof(Rocks_SDL2GlyphAtlas));
+    if (!atlas) return NULL;
+
+    atlas->font = font;
+    atlas->width = ROCKS_GLYPH_ATLAS_SIZE;
+    atlas->height = ROCKS_GLYPH_ATLAS_SIZE;
+    atlas->glyph_capacity = ROCKS_GLYPH_TABLE_INITIAL_CAPACITY;
+    atlas->glyphs = calloc(atlas->glyph_capacity, sizeof(Rocks_SDL2Glyph));
+
+    atlas->texture = SDL_CreateTexture(
+        renderer,
+        SDL_PIXELFORMAT_ARGB8888,
+        SDL_TEXTUREACCESS_STATIC,
+        atlas->width,
+        atlas->height
+    );
+
+    if (!atlas->glyphs || !atlas->texture || !GrowVertices(atlas, ROCKS_GLYPH_VERTEX_INITIAL_CAPACITY)) {
+        printf("ERROR: Failed to create glyph atlas: %s\n", SDL_GetError());
+        Rocks_DestroyGlyphAtlasSDL2(atlas);
+        return NULL;
+    }
+
+    // Texture contents start undefined; clear them so filtering at glyph
+    // edges only ever samples transparent padding.
+    void* zeroes = calloc((size_t)atlas->width * atlas->height, 4);
+    if (zeroes) {
+        SDL_UpdateTexture(atlas->texture, NULL, zeroes, atlas->width * 4);
+        free(zeroes);
+    }
+
+    SDL_SetTextureBlendMode(atlas->texture, SDL_BLENDMODE_BLEND);
+    return atlas;
+}
+
+void Rocks_DestroyGlyphAtlasSDL2(Rocks_SDL2GlyphAtlas* atlas) {
+    if (!atlas) return;
+
+    if (atlas->texture) {
+        SDL_DestroyTexture(atlas->texture);
+    }
+    free(atlas->glyphs);
+    free(atlas->vertices);
+    free(atlas->indices);
+    free(atlas);
+}
+
+void Rocks_DrawTextSDL2(
+    SDL_Renderer* renderer,
+    Rocks_SDL2GlyphAtlas* atlas,
+    Clay_StringSlice text,
+    float x,
+    float y,
+    float scale,
+    SDL_Color color
+) {
+    if (!renderer || !atlas || !text.chars || text.length <= 0) return;
+
+    atlas->vertex_count = 0;
+
+    int pen_x = 0;
+    uint32_t previous = 0;
+    int32_t index = 0;
+
+    while (index < text.length) {
+        uint32_t codepoint = DecodeUTF8(text.chars, text.length, &index);
+        if (codepoint == '\n' || codepoint == '\r') {
+            previous = 0;
+            continue;
+        }
+
+        if (previous) {
+            pen_x += TTF_GetFontKerningSizeGlyphs32(atlas->font, previous, codepoint);
+        }
+        previous = codepoint;
+
+        Rocks_SDL2Glyph* glyph = FindSlot(atlas->glyphs, atlas->glyph_capacity, codepoint);
+        if (glyph->codepoint != codepoint) {
+            bool full = false;
+            glyph = AddGlyph(atlas, codepoint, &full);
+
+            if (!glyph && full) {
+                // Draw what is queued before its glyphs get overwritten
+                FlushVertices(renderer, atlas);
+                ResetAtlas(atlas);
+                glyph = AddGlyph(atlas, codepoint, &full);
+            }
+
+            if (!glyph) continue;
+        }
+
+        if (glyph->src.w > 0) {
+            SDL_FRect dst = {
+                x + (pen_x + glyph->offset_x) * scale,
+                y,
+                glyph->src.w * scale,
+                glyph->src.h * scale
+            };
+            PushQuad(atlas, dst, glyph->src, color);
+        }
+
+        pen_x += glyph->advance;
+    }
+
+    FlushVertices(renderer, atlas);
+}
@@ -0,0 +1,143 @@
+#include "renderer/sdl2_layer_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static void ReleaseLayer(void* entry) {
+    Rocks_SDL2Layer* layer = entry;
+    if (layer->texture) {
+        SDL_DestroyTexture(layer->texture);
+    }
+    if (layer->spare) {
+        SDL_DestroyTexture(layer->spare);
+    }
+    Rocks_FreeDamageTracker(&layer->damage);
+    *layer = (Rocks_SDL2Layer){0};
+}
+
+Rocks_SDL2LayerCache* Rocks_CreateLayerCacheSDL2(void) {
+    Rocks_SDL2LayerCache* cache = calloc(1, sizeof(Rocks_SDL2LayerCache));
+    if (!cache) return NULL;
+    Rocks_InitLayerTable(&cache->table, cache->entries, sizeof(Rocks_SDL2Layer), ReleaseLayer);
+
+    // Drawing into a cleared target leaves color premultiplied by alpha
+    cache->blend_mode = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD
+    );
+    return cache;
+}
+
+void Rocks_DestroyLayerCacheSDL2(Rocks_SDL2LayerCache* cache) {
+    if (!cache) return;
+    Rocks_ClearLayerTable(&cache->table);
+    free(cache);
+}
+
+void Rocks_BeginLayerCacheFrameSDL2(Rocks_SDL2LayerCache* cache) {
+    if (!cache) return;
+    Rocks_BeginLayerTableFrame(&cache->table);
+}
+
+void Rocks_InvalidateLayersSDL2(Rocks_SDL2LayerCache* cache) {
+    if (!cache) return;
+    Rocks_InvalidateLayerTable(&cache->table);
+}
+
+static SDL_Texture* CreateLayerTexture(Rocks_SDL2LayerCache* cache, SDL_Renderer* renderer, int width, int height) {
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!texture) {
+        printf("Failed to create layer texture: %s\n", SDL_GetError());
+        return NULL;
+    }
+
+    if (SDL_SetTextureBlendMode(texture, cache->blend_mode) != 0) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    return texture;
+}
+
+// Finds or makes room for the entry of `id` and gives it a texture of the
+// given size. `stale` is set when the texture must be redrawn in full.
+static Rocks_SDL2Layer* AcquireLayer(
+    Rocks_SDL2LayerCache* cache,
+    SDL_Renderer* renderer,
+    uint32_t id,
+    bool scrolls,
+    uint64_t hash,
+    int width,
+    int height,
+    bool* stale
+) {
+    if (!cache || !renderer || width <= 0 || height <= 0) return NULL;
+
+    Rocks_SDL2Layer* layer = Rocks_AcquireLayerEntry(&cache->table, id, scrolls);
+    if (!layer) return NULL;
+
+    if (layer->texture && (layer->width != width || layer->height != height)) {
+        SDL_DestroyTexture(layer->texture);
+        layer->texture = NULL;
+        if (layer->spare) {
+            SDL_DestroyTexture(layer->spare);
+            layer->spare = NULL;
+        }
+    }
+    if (!layer->texture) {
+        layer->texture = CreateLayerTexture(cache, renderer, width, height);
+        if (!layer->texture) return NULL;
+        layer->width = width;
+        layer->height = height;
+        layer->slot.dirty = true;
+    }
+
+    *stale = Rocks_TakeLayerStale(&layer->slot, hash);
+    return layer;
+}
+
+Rocks_SDL2Layer* Rocks_GetLayerSDL2(
+    Rocks_SDL2LayerCache* cache,
+    SDL_Renderer* renderer,
+    uint32_t id,
+    uint64_t hash,
+    int width,
+    int height,
+    bool* stale
+) {
+    return AcquireLayer(cache, renderer, id, false, hash, width, height, stale);
+}
+
+Rocks_SDL2Layer* Rocks_GetScrollLayerSDL2(
+    Rocks_SDL2LayerCache* cache,
+    SDL_Renderer* renderer,
+    uint32_t id,
+    int width,
+    int height,
+    bool* stale
+) {
+    return AcquireLayer(cache, renderer, id, true, 0, width, height, stale);
+}
+
+bool Rocks_ShiftScrollLayerSDL2(Rocks_SDL2LayerCache* cache, SDL_Renderer* renderer, Rocks_SDL2Layer* layer, int dx, int dy) {
+    if (!layer->spare) {
+        layer->spare = CreateLayerTexture(cache, renderer, layer->width, layer->height);
+        if (!layer->spare) return false;
+    }
+
+    SDL_BlendMode blend_mode;
+    SDL_GetTextureBlendMode(layer->texture, &blend_mode);
+    SDL_SetTextureBlendMode(layer->texture, SDL_BLENDMODE_NONE);
+
+    SDL_Texture* target = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, layer->spare);
+    SDL_RenderSetClipRect(renderer, NULL);
+    SDL_Rect dest = { dx, dy, layer->width, layer->height };
+    SDL_RenderCopy(renderer, layer->texture, NULL, &dest);
+    SDL_SetRenderTarget(renderer, target);
+
+    SDL_SetTextureBlendMode(layer->texture, blend_mode);
+
+    SDL_Texture* swap = layer->texture;
+    layer->texture = layer->spare;
+    layer->spare = swap;
+    return true;
+}
@@ -1,5 +1,9 @@
 #include "renderer/sdl2_renderer.h"
 #include "renderer/sdl2_renderer_utils.h"
+#include "rocks_measure_cache.h"
+#include "rocks_pipeline.h"
+#include "rocks_profile.h"
+#include "rocks.h"
 
 #define NANOSVG_IMPLEMENTATION 
 #include "nanosvg.h"
@@ -86,7 +90,9 @@ void* Rocks_LoadImageSDL2(Rocks* rocks, const char* path) {
         }
     } else {
         // Load non-SVG image using SDL_image
+        ROCKS_PROFILE_BEGIN(image_decode);
         surface = IMG_Load(path);
+        ROCKS_PROFILE_END(image_decode);
         if (!surface) {
             printf("Failed to load image: %s - %s\n", path, IMG_GetError());
             return NULL;
@@ -94,7 +100,9 @@ void* Rocks_LoadImageSDL2(Rocks* rocks, const char* path) {
     }
 
     // Convert surface to texture
+    ROCKS_PROFILE_BEGIN(image_upload);
     SDL_Texture* texture = SDL_CreateTextureFromSurface(r->renderer, surface);
+    ROCKS_PROFILE_END(image_upload);
     SDL_FreeSurface(surface);
 
     // If SVG, free the rasterized data (SDL_CreateRGBSurfaceFrom doesn't copy it)
@@ -182,7 +190,9 @@ void* Rocks_LoadImageFromMemorySDL2(Rocks* rocks, const char* data, size_t lengt
             return NULL;
         }
 
+        ROCKS_PROFILE_BEGIN(image_decode);
         surface = IMG_Load_RW(rw, 1); // 1 means RWops will be freed
+        ROCKS_PROFILE_END(image_decode);
         if (!surface) {
             printf("Failed to load image from memory: %s\n", IMG_GetError());
             return NULL;
@@ -190,7 +200,9 @@ void* Rocks_LoadImageFromMemorySDL2(Rocks* rocks, const char* data, size_t lengt
     }
 
     // Convert surface to texture
+    ROCKS_PROFILE_BEGIN(image_upload);
     SDL_Texture* texture = SDL_CreateTextureFromSurface(r->renderer, surface);
+    ROCKS_PROFILE_END(image_upload);
     SDL_FreeSurface(surface);
 
     // If SVG, free the rasterized data (SDL_CreateRGBSurfaceFrom doesn't copy it)
@@ -224,33 +236,18 @@ Clay_Dimensions Rocks_GetImageDimensionsSDL2(Rocks* rocks, void* image_data) {
         .height = (float)h
     };
 }
+// Innermost scroll container under the pointer. Its data is copied into
+// the renderer, and its scroll position still points into Clay.
 static Clay_ScrollContainerData* FindActiveScrollContainer(Rocks_SDL2Renderer* r, Clay_Vector2 pointerPosition) {
-    Clay_SetPointerState(pointerPosition, false);
+    const Rocks_ScrollEntry* entry = Rocks_ScrollEntryAt(&r->scroll_registry, pointerPosition.x, pointerPosition.y);
+    if (!entry) return NULL;
 
-    Clay_ElementId scrollId = {0};
-    bool found = false;
-    
-    for (int i = 0; i < r->scroll_container_count; i++) {
-        if (Clay_PointerOver((Clay_ElementId){.id = r->scroll_containers[i].elementId})) {
-            scrollId.id = r->scroll_containers[i].elementId;
-            found = true;
-            break;
-        }
-    }
+    Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData((Clay_ElementId){.id = entry->id});
+    if (!scrollData.found) return NULL;
 
-    if (found) {
-        Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(scrollId);
-        if (scrollData.found) {
-            Clay_ScrollContainerData* activeScroll = malloc(sizeof(Clay_ScrollContainerData));
-            if (activeScroll) {
-                *activeScroll = scrollData;
-                r->active_scroll_container_id = scrollId.id;
-                return activeScroll;
-            }
-        }
-    }
-    
-    return NULL;
+    r->active_scroll_data = scrollData;
+    r->active_scroll_container_id = entry->id;
+    return &r->active_scroll_data;
 }
 
 static void HandlePointerDragging(Rocks_SDL2Renderer* r, float x, float y) {
@@ -283,26 +280,11 @@ static void HandlePointerDragging(Rocks_SDL2Renderer* r, float x, float y) {
         scrollData->scrollPosition->x = newScrollX;
     }
     else if (r->is_scroll_dragging) {
-
-        float deltaY = (r->scroll_drag_start_y - y) / r->scale_factor;
-        float deltaX = (r->scroll_drag_start_x - x) / r->scale_factor;
-        
-        float newScrollY = r->initial_scroll_position.y;
-        float newScrollX = r->initial_scroll_position.x;
-        
-        if (scrollData->config.vertical) {
-            float scrollableHeight = scrollData->contentDimensions.height - scrollData->scrollContainerDimensions.height;
-            newScrollY = r->initial_scroll_position.y - deltaY;
-            newScrollY = CLAY__MIN(0, CLAY__MAX(newScrollY, -scrollableHeight));
-        }
-        
-        if (scrollData->config.horizontal) {
-            float scrollableWidth = scrollData->contentDimensions.width - scrollData->scrollContainerDimensions.width;
-            newScrollX = r->initial_scroll_position.x - deltaX;
-            newScrollX = CLAY__MIN(0, CLAY__MAX(newScrollX, -scrollableWidth));
-        }
-        
-        *scrollData->scrollPosition = (Clay_Vector2){newScrollX, newScrollY};
+        Clay_Vector2 delta = {
+            scrollData->config.horizontal ? (x - r->scroll_drag_start_x) / r->scale_factor : 0,
+            scrollData->config.vertical ? (y - r->scroll_drag_start_y) / r->scale_factor : 0
+        };
+        Rocks_DragScroll(&r->scroll_physics, r->active_scroll_container_id, scrollData, delta, Rocks_GetTimeSDL2());
         
         r->scroll_drag_start_y = y;
         r->scroll_drag_start_x = x;
@@ -312,10 +294,7 @@ static void HandlePointerDragging(Rocks_SDL2Renderer* r, float x, float y) {
 
 
 static void CleanupActiveScrollContainer(Rocks_SDL2Renderer* r) {
-    if (r->active_scroll_container) {
-        free(r->active_scroll_container);
-        r->active_scroll_container = NULL;
-    }
+    r->active_scroll_container = NULL;
     r->active_scroll_container_id = 0;
     r->is_scroll_dragging = false;
     r->is_scroll_thumb_dragging = false;
@@ -329,38 +308,31 @@ static void ResetScrollContainer(Rocks_SDL2Renderer* r) {
     r->active_scroll_container_id = 0;
 }
 
-typedef struct {
-    float velocity_x;
-    float velocity_y;
-    float last_scroll_time;
-} Rocks_InertialScrollState;
-
-static Rocks_InertialScrollState inertial_scroll_state = {0};
-
 static float GetScrollSensitivity(Clay_ScrollContainerData* scrollData) {
     float base_sensitivity = 5.0f;
     float content_size_factor = scrollData->contentDimensions.height / scrollData->scrollContainerDimensions.height;
     return base_sensitivity * content_size_factor;
 }
 
-static void ClamyScrollPosition(Clay_ScrollContainerData* scrollData) {
-    float scrollableWidth = scrollData->contentDimensions.width - scrollData->scrollContainerDimensions.width;
-    float scrollableHeight = scrollData->contentDimensions.height - scrollData->scrollContainerDimensions.height;
+// How far a wheel moves this container's content
+static Clay_Vector2 GetWheelDeltaSDL2(Clay_ScrollContainerData* scrollData, float wheelX, float wheelY) {
+    float scrollMultiplier = GetScrollSensitivity(scrollData);
+    Clay_Vector2 scrollDelta = {0, 0};
 
-    scrollData->scrollPosition->x = CLAY__MIN(0, CLAY__MAX(scrollData->scrollPosition->x, -scrollableWidth));
-    scrollData->scrollPosition->y = CLAY__MIN(0, CLAY__MAX(scrollData->scrollPosition->y, -scrollableHeight));
-}
-
-static Uint32 last_scroll_time = 0;
-static const Uint32 SCROLL_DEBOUNCE_TIME = 50; // 50ms debounce time
-
-static bool ShouldProcessScrollEvent() {
-    Uint32 current_time = SDL_GetTicks();
-    if (current_time - last_scroll_time < SCROLL_DEBOUNCE_TIME) {
-        return false;
+    if (wheelX != 0 && scrollData->config.horizontal) {
+        scrollDelta.x = -wheelX * scrollMultiplier;
     }
-    last_scroll_time = current_time;
-    return true;
+    else if (wheelY != 0) {
+        bool preferHorizontal = (scrollData->contentDimensions.width > scrollData->contentDimensions.height) ||
+                            (scrollData->config.horizontal && !scrollData->config.vertical);
+
+        if (preferHorizontal && scrollData->config.horizontal) {
+            scrollDelta.x = wheelY * scrollMultiplier;
+        } else if (scrollData->config.vertical) {
+            scrollDelta.y = wheelY * scrollMultiplier;
+        }
+    }
+    return scrollDelta;
 }
 
 static void handle_mouse_scrollbar_interaction(
@@ -369,10 +341,10 @@ static void handle_mouse_scrollbar_interaction(
     Clay_ScrollContainerData* scrollData,
     Clay_ElementId elementId
 ) {
-    Clay_ElementData elementData = Clay_GetElementData(elementId);
-    if (!elementData.found) return;
+    const Rocks_ScrollEntry* entry = Rocks_FindScrollEntry(&r->scroll_registry, elementId.id);
+    if (!entry) return;
 
-    Clay_BoundingBox containerBox = elementData.boundingBox;
+    Clay_BoundingBox containerBox = entry->bounds;
     float scaledMouseX = event->x / r->scale_factor;
     float scaledMouseY = event->y / r->scale_factor;
     
@@ -447,34 +419,166 @@ static void handle_mouse_scrollbar_interaction(
     r->scroll_drag_start_x = event->x;
     r->initial_scroll_position = *scrollData->scrollPosition;
 }
+static void BuildAsciiMetricsSDL2(TTF_Font* font, Rocks_AsciiMetrics* metrics) {
+    memset(metrics, 0, sizeof(Rocks_AsciiMetrics));
+
+    for (int c = ROCKS_ASCII_FIRST; c <= ROCKS_ASCII_LAST; c++) {
+        int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+        if (TTF_GlyphMetrics32(font, c, &minx, &maxx, &miny, &maxy, &advance) != 0) {
+            return;
+        }
+        metrics->advances[c] = (float)advance;
+        metrics->min_x[c] = (float)minx;
+        metrics->max_x[c] = (float)maxx;
+    }
+
+    if (TTF_GetFontKerning(font)) {
+        int16_t* kerning = calloc(ROCKS_ASCII_COUNT * ROCKS_ASCII_COUNT, sizeof(int16_t));
+        bool any = false;
+
+        for (int a = 0; kerning && a < ROCKS_ASCII_COUNT; a++) {
+            for (int b = 0; b < ROCKS_ASCII_COUNT; b++) {
+                int kern = TTF_GetFontKerningSizeGlyphs32(font, a + ROCKS_ASCII_FIRST, b + ROCKS_ASCII_FIRST);
+                kerning[a * ROCKS_ASCII_COUNT + b] = (int16_t)kern;
+                any = any || kern != 0;
+            }
+        }
+
+        if (any) {
+            metrics->kerning = kerning;
+        } else {
+            free(kerning);
+        }
+    }
+
+    metrics->line_height = (float)TTF_FontHeight(font);
+    metrics->valid = true;
+}
+
+static void RetireGlyphAtlasSDL2(Rocks_SDL2Renderer* r, Rocks_SDL2GlyphAtlas* atlas) {
+    if (!atlas) return;
+
+    if (r->retired_atlas_count == r->retired_atlas_capacity) {
+        int capacity = r->retired_atlas_capacity ? r->retired_atlas_capacity * 2 : 8;
+        Rocks_SDL2GlyphAtlas** grown = realloc(r->retired_atlases, capacity * sizeof(Rocks_SDL2GlyphAtlas*));
+        if (!grown) {
+            Rocks_DestroyGlyphAtlasSDL2(atlas);
+            return;
+        }
+        r->retired_atlases = grown;
+        r->retired_atlas_capacity = capacity;
+    }
+    r->retired_atlases[r->retired_atlas_count++] = atlas;
+}
+
+static void DestroyRetiredAtlasesSDL2(Rocks_SDL2Renderer* r) {
+    for (int i = 0; i < r->retired_atlas_count; i++) {
+        Rocks_DestroyGlyphAtlasSDL2(r->retired_atlases[i]);
+    }
+    r->retired_atlas_count = 0;
+}
+
+static void ReleaseFontVariantSDL2(Rocks_SDL2Renderer* r, Rocks_SDL2FontVariant* variant) {
+    RetireGlyphAtlasSDL2(r, variant->atlas);
+    Rocks_FreeAsciiMetrics(&variant->ascii);
+    if (variant->font) {
+        TTF_CloseFont(variant->font);
+    }
+    memset(variant, 0, sizeof(Rocks_SDL2FontVariant));
+}
+
+static void ReleaseFontSDL2(Rocks_SDL2Renderer* r, RockSDL2Font* entry) {
+    for (int i = 0; i < entry->variant_set.count; i++) {
+        Rocks_SDL2FontVariant* variant = entry->variant_set.slots[i].variant;
+        if (!variant) continue;
+        ReleaseFontVariantSDL2(r, variant);
+        free(variant);
+    }
+    Rocks_FreeFontVariantSet(&entry->variant_set);
+    Rocks_ReleaseFontFace(entry->face);
+    memset(entry, 0, sizeof(RockSDL2Font));
+}
+
+// Opens the requested size from the shared face on first use, reusing the
+// slot of a size that has gone unused once the font id holds
+// ROCKS_FONT_VARIANT_SOFT_LIMIT
+static Rocks_SDL2FontVariant* GetFontVariantSDL2(Rocks_SDL2Renderer* r, uint16_t font_id, uint16_t font_size) {
+    if (font_id >= 32 || !r->fonts[font_id].face) return NULL;
+
+    RockSDL2Font* entry = &r->fonts[font_id];
+    int size = (int)((font_size > 0 ? font_size : entry->size) * r->scale_factor);
+    if (size <= 0) return NULL;
+
+    bool needs_load = false;
+    int slot = Rocks_AcquireFontVariant(&entry->variant_set, size, Rocks_GetFrameIndex(), &needs_load);
+    if (slot < 0) return NULL;
+
+    Rocks_SDL2FontVariant* variant = entry->variant_set.slots[slot].variant;
+    if (!needs_load) return variant;
+
+    if (variant) {
+        ReleaseFontVariantSDL2(r, variant);
+    } else {
+        variant = calloc(1, sizeof(Rocks_SDL2FontVariant));
+        if (!variant) return NULL;
+        entry->variant_set.slots[slot].variant = variant;
+    }
+
+    // The face outlives every variant, so the font can read it in place
+    SDL_RWops* rw = SDL_RWFromConstMem(entry->face->data, (int)entry->face->size);
+    variant->font = rw ? TTF_OpenFontRW(rw, 1, size) : NULL;
+    if (!variant->font) {
+        printf("ERROR: TTF_OpenFontRW failed for %s at %dpx: %s\n", entry->face->path, size, TTF_GetError());
+        Rocks_SetFontVariant(&entry->variant_set, slot, 0);
+        return NULL;
+    }
+
+    BuildAsciiMetricsSDL2(variant->font, &variant->ascii);
+
+    Rocks_SetFontVariant(&entry->variant_set, slot, size);
+    return variant;
+}
+
 static Clay_Dimensions Rocks_MeasureTextSDL2(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData) {
     Rocks_SDL2Renderer* r = (Rocks_SDL2Renderer*)userData;
     
-    if (config->fontId >= 32 || !r->fonts[config->fontId].font) {
+    Rocks_SDL2FontVariant* variant = GetFontVariantSDL2(r, config->fontId, config->fontSize);
+    if (!variant) {
         return (Clay_Dimensions){0, 0};
     }
 
-    TTF_Font* font = r->fonts[config->fontId].font;
+    TTF_Font* font = variant->font;
     
     if (!text.chars || text.length == 0) {
         return (Clay_Dimensions){0, (float)TTF_FontHeight(font)};
     }
 
-    char* buffer = (char*)SDL_AllocateAligned(8, text.length + 1);
-    if (!buffer) {
-        return (Clay_Dimensions){0, 0};
+    Rocks_AsciiMetrics* ascii = &variant->ascii;
+    if (ascii->valid && Rocks_IsPrintableAscii(text)) {
+        return (Clay_Dimensions){
+            .width = Rocks_MeasureAsciiWidth(ascii, text),
+            .height = ascii->line_height
+        };
     }
 
-    memcpy(buffer, text.chars, text.length);
-    buffer[text.length] = '\0';
+    // Grow-only scratch buffer; TTF_SizeUTF8 needs a terminated string
+    if (r->measure_buffer_size < (size_t)text.length + 1) {
+        char* buffer = realloc(r->measure_buffer, text.length + 1);
+        if (!buffer) {
+            return (Clay_Dimensions){0, 0};
+        }
+        r->measure_buffer = buffer;
+        r->measure_buffer_size = text.length + 1;
+    }
+
+    memcpy(r->measure_buffer, text.chars, text.length);
+    r->measure_buffer[text.length] = '\0';
 
     int width = 0, height = 0;
-    if (TTF_SizeUTF8(font, buffer, &width, &height) != 0) {
-        SDL_FreeAligned(buffer);
+    if (TTF_SizeUTF8(font, r->measure_buffer, &width, &height) != 0) {
         return (Clay_Dimensions){0, 0};
     }
 
-    SDL_FreeAligned(buffer);
     return (Clay_Dimensions){
         .width = (float)width,
         .height = (float)height
@@ -482,6 +586,35 @@ static Clay_Dimensions Rocks_MeasureTextSDL2(Clay_StringSlice text, Clay_TextEle
 }
 
 
+// Scrollbars are drawn from scroll state rather than render data, so their
+// position, fade and a pointer over them feed the damage hash of the container
+static uint64_t HashScrollbarStateSDL2(const Clay_RenderCommand* cmd, void* userData) {
+    if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) return 0;
+
+    Clay_ScrollContainerData scrollData = Rocks_GetScrollContainerData((Clay_ElementId){ .id = cmd->id });
+    if (!scrollData.found) return 0;
+
+    Rocks_SDL2Renderer* r = userData;
+    uint64_t hash = ROCKS_DAMAGE_HASH_SEED;
+    hash = Rocks_DamageHash(hash, scrollData.scrollPosition, sizeof(Clay_Vector2));
+    hash = Rocks_DamageHash(hash, &scrollData.contentDimensions, sizeof(Clay_Dimensions));
+    hash = Rocks_DamageHash(hash, &r->scrollbar_opacity, sizeof(float));
+
+    int mouseX, mouseY;
+    SDL_GetMouseState(&mouseX, &mouseY);
+    float x = mouseX / r->scale_factor;
+    float y = mouseY / r->scale_factor;
+
+    // Same 10 unit strip RenderScrollbar draws along the edges
+    Clay_BoundingBox box = cmd->boundingBox;
+    bool inside = x >= box.x && x <= box.x + box.width && y >= box.y && y <= box.y + box.height;
+    if (inside && (x >= box.x + box.width - 10 || y >= box.y + box.height - 10)) {
+        hash = Rocks_DamageHash(hash, &mouseX, sizeof(mouseX));
+        hash = Rocks_DamageHash(hash, &mouseY, sizeof(mouseY));
+    }
+    return hash;
+}
+
 bool Rocks_InitSDL2(Rocks* rocks, void* config) {
     printf("Initializing SDL2 renderer...\n");
 
@@ -548,10 +681,11 @@ bool Rocks_InitSDL2(Rocks* rocks, void* config) {
     }
 
     printf("Creating SDL renderer...\n");
-    r->renderer = SDL_CreateRenderer(
-        r->window, -1, 
-        sdl_config->renderer_flags | SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE
-    );
+    Uint32 renderer_flags = sdl_config->renderer_flags | SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+    if (sdl_config->vsync || rocks->config.frame_pacing == ROCKS_FRAME_PACING_VSYNC) {
+        renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    r->renderer = SDL_CreateRenderer(r->window, -1, renderer_flags);
 
     if (!r->renderer) {
         printf("Error: Failed to create renderer: %s\n", SDL_GetError());
@@ -563,6 +697,20 @@ bool Rocks_InitSDL2(Rocks* rocks, void* config) {
     SDL_SetRenderDrawBlendMode(r->renderer, SDL_BLENDMODE_BLEND);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
 
+    r->batch.renderer = r->renderer;
+    r->shadow_cache = Rocks_CreateShadowCacheSDL2();
+
+    r->backbuffer_failed = !SDL_RenderTargetSupported(r->renderer);
+    r->layer_cache = Rocks_CreateLayerCacheSDL2();
+    r->damage.extra_hash = HashScrollbarStateSDL2;
+    r->damage.user_data = r;
+
+    if (sdl_config->text_cache_budget > 0) {
+        r->text_cache = Rocks_CreateTextCacheSDL2(sdl_config->text_cache_budget);
+        r->text_cache_max_age = sdl_config->text_cache_max_age > 0 ?
+            sdl_config->text_cache_max_age : ROCKS_TEXT_CACHE_DEFAULT_MAX_AGE;
+    }
+
     printf("Setting up cursors...\n");
     r->default_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_ARROW);
     r->pointer_cursor = SDL_CreateSystemCursor(SDL_SYSTEM_CURSOR_HAND);
@@ -570,7 +718,7 @@ bool Rocks_InitSDL2(Rocks* rocks, void* config) {
     SDL_SetCursor(r->current_cursor);
 
     printf("Setting up text measurement function...\n");
-    Clay_SetMeasureTextFunction(Rocks_MeasureTextSDL2, (void*)r); 
+    Rocks_SetMeasureTextFunction(Rocks_MeasureTextSDL2, (void*)r);
     rocks->renderer_data = r;
 
     printf("SDL2 renderer initialized successfully\n");
@@ -581,11 +729,27 @@ void Rocks_CleanupSDL2(Rocks* rocks) {
     Rocks_SDL2Renderer* r = rocks->renderer_data;
     if (!r) return;
     
+    Rocks_DestroyTextCacheSDL2(r->text_cache);
+    Rocks_FreeGeometryBatchSDL2(&r->batch);
+    Rocks_FreeHitIndex(&r->hit_index);
+    Rocks_FreeScrollRegistry(&r->scroll_registry);
+    Rocks_FreeScrollPhysics(&r->scroll_physics);
+    Rocks_DestroyShadowCacheSDL2(r->shadow_cache);
+
     for (int i = 0; i < 32; i++) {
-        if (r->fonts[i].font) {
-            TTF_CloseFont(r->fonts[i].font);
-        }
+        ReleaseFontSDL2(r, &r->fonts[i]);
     }
+    DestroyRetiredAtlasesSDL2(r);
+    free(r->retired_atlases);
+
+    if (r->backbuffer) {
+        SDL_DestroyTexture(r->backbuffer);
+    }
+    Rocks_FreeDamageTracker(&r->damage);
+    Rocks_DestroyLayerCacheSDL2(r->layer_cache);
+    free(r->layer_commands);
+
+    free(r->measure_buffer);
 
     SDL_FreeCursor(r->default_cursor);
     SDL_FreeCursor(r->pointer_cursor);
@@ -608,26 +772,25 @@ uint16_t Rocks_LoadFontSDL2(Rocks* rocks, const char* path, int size, uint16_t e
     }
 
     // Check if this slot is already taken
-    if (r->fonts[expected_id].font) {
+    if (r->fonts[expected_id].face) {
         printf("ERROR: Font ID %u is already in use\n", expected_id);
         return UINT16_MAX;
     }
 
-    FILE* f = fopen(path, "rb");
-    if (!f) {
+    RockSDL2Font* entry = &r->fonts[expected_id];
+    entry->face = Rocks_AcquireFontFace(path);
+    if (!entry->face) {
         printf("ERROR: Could not open font file: %s\n", path);
         return UINT16_MAX;
     }
-    fclose(f);
-    
-    TTF_Font* font = TTF_OpenFont(path, size * r->scale_factor);
+    entry->size = size;
 
-    if (!font) {
-        printf("ERROR: TTF_OpenFont failed for %s: %s\n", path, TTF_GetError());
+    // Open the load size up front so a bad font fails here, not mid-frame
+    if (!GetFontVariantSDL2(r, expected_id, 0)) {
+        ReleaseFontSDL2(r, entry);
         return UINT16_MAX;
     }
 
-    r->fonts[expected_id].font = font;
     return expected_id;
 }
 
@@ -635,14 +798,26 @@ void Rocks_UnloadFontSDL2(Rocks* rocks, uint16_t font_id) {
     Rocks_SDL2Renderer* r = rocks->renderer_data;
     if (!r || font_id >= 32) return;
 
-    if (r->fonts[font_id].font) {
-        TTF_CloseFont(r->fonts[font_id].font);
-        r->fonts[font_id].font = NULL;
-    }
+    Rocks_InvalidateTextCacheFontSDL2(r->text_cache, font_id);
+    ReleaseFontSDL2(r, &r->fonts[font_id]);
+    Rocks_InvalidateDamage(&r->damage);
+    Rocks_InvalidateLayersSDL2(r->layer_cache);
 }
 
-float Rocks_GetTimeSDL2(void) {
-    return SDL_GetTicks() / 1000.0f;
+double Rocks_GetTimeSDL2(void) {
+    // Counted from the first call so the double keeps its precision
+    static Uint64 origin = 0;
+    if (!origin) origin = SDL_GetPerformanceCounter();
+    return (double)(SDL_GetPerformanceCounter() - origin) / (double)SDL_GetPerformanceFrequency();
+}
+
+float Rocks_GetRefreshRateSDL2(Rocks* rocks) {
+    Rocks_SDL2Renderer* r = rocks->renderer_data;
+    if (!r || !r->window) return 0.0f;
+
+    SDL_DisplayMode mode;
+    if (SDL_GetWindowDisplayMode(r->window, &mode) != 0) return 0.0f;
+    return (float)mode.refresh_rate;
 }
 
 void Rocks_SetWindowSizeSDL2(Rocks* rocks, int width, int height) {
@@ -677,16 +852,20 @@ void Rocks_ToggleFullscreenSDL2(Rocks* rocks) {
 void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
     Rocks_SDL2Renderer* r = rocks->renderer_data;
     SDL_Event* sdl_event = (SDL_Event*)event;
-    static float last_time = 0;
-    float current_time = SDL_GetTicks() / 1000.0f;
-    float delta_time = current_time - last_time;
-    last_time = current_time;
+    double current_time = Rocks_GetTimeSDL2();
 
     switch (sdl_event->type) {
         case SDL_QUIT:
             rocks->is_running = false;
             break;
 
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+            // Backbuffer and layer contents are lost
+            Rocks_InvalidateDamage(&r->damage);
+            Rocks_InvalidateLayersSDL2(r->layer_cache);
+            break;
+
         case SDL_WINDOWEVENT:
             if (sdl_event->window.event == SDL_WINDOWEVENT_RESIZED) {
                 rocks->config.window_width = sdl_event->window.data1 / r->scale_factor;
@@ -698,47 +877,30 @@ void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
             }
             break;
         case SDL_MOUSEWHEEL: {
-            if (!ShouldProcessScrollEvent()) {
-                break;
-            }
-
             Clay_Vector2 currentPos = {
                 (float)sdl_event->wheel.mouseX / r->scale_factor,
                 (float)sdl_event->wheel.mouseY / r->scale_factor
             };
 
-            r->active_scroll_container = FindActiveScrollContainer(r, currentPos);
+            // Trackpads report fractions of a notch
+            float wheelX = sdl_event->wheel.preciseX;
+            float wheelY = sdl_event->wheel.preciseY;
 
-            // Check if active_scroll_container is valid
-            if (!r->active_scroll_container) {
-                printf("No active scroll container found under pointer.\n");
-                break;
-            }
+            // Containers that cannot move that way pass the wheel outwards
+            const Rocks_ScrollEntry* entry = Rocks_ScrollEntryAt(&r->scroll_registry, currentPos.x, currentPos.y);
+            for (; entry; entry = Rocks_GetScrollParent(&r->scroll_registry, entry)) {
+                Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData((Clay_ElementId){.id = entry->id});
+                if (!scrollData.found) continue;
 
-            float scrollMultiplier = GetScrollSensitivity(r->active_scroll_container);
-            Clay_Vector2 scrollDelta = {0, 0};
+                Clay_Vector2 scrollDelta = GetWheelDeltaSDL2(&scrollData, wheelX, wheelY);
+                if (!Rocks_CanScrollBy(&scrollData, scrollDelta)) continue;
 
-            if (sdl_event->wheel.x != 0 && r->active_scroll_container->config.horizontal) {
-                scrollDelta.x = -sdl_event->wheel.x * scrollMultiplier;
-            }
-            else if (sdl_event->wheel.y != 0) {
-                bool preferHorizontal = (r->active_scroll_container->contentDimensions.width > r->active_scroll_container->contentDimensions.height) ||
-                                    (r->active_scroll_container->config.horizontal && !r->active_scroll_container->config.vertical);
-
-                if (preferHorizontal && r->active_scroll_container->config.horizontal) {
-                    scrollDelta.x = sdl_event->wheel.y * scrollMultiplier;
-                } else if (r->active_scroll_container->config.vertical) {
-                    scrollDelta.y = sdl_event->wheel.y * scrollMultiplier;
-                }
+                r->active_scroll_data = scrollData;
+                r->active_scroll_container = &r->active_scroll_data;
+                r->active_scroll_container_id = entry->id;
+                Rocks_ScrollBy(&r->scroll_physics, entry->id, r->active_scroll_container, scrollDelta);
+                break;
             }
-
-            Clay_UpdateScrollContainers(true, scrollDelta, delta_time);
-            ClamyScrollPosition(r->active_scroll_container);
-
-            // Update inertial scroll velocity
-            inertial_scroll_state.velocity_x = scrollDelta.x / delta_time;
-            inertial_scroll_state.velocity_y = scrollDelta.y / delta_time;
-            inertial_scroll_state.last_scroll_time = SDL_GetTicks();
             break;
         }
 
@@ -760,6 +922,7 @@ void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
                         break;
                     }
                     
+                    Rocks_StopScroll(&r->scroll_physics, r->active_scroll_container_id);
                     handle_mouse_scrollbar_interaction(
                         r,
                         &sdl_event->button,
@@ -802,6 +965,9 @@ void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
             
             Clay_SetPointerState(upPosition, false);
             
+            if (r->is_scroll_dragging) {
+                Rocks_ReleaseScroll(&r->scroll_physics, r->active_scroll_container_id, current_time);
+            }
             ResetScrollContainer(r);
             CleanupActiveScrollContainer(r);
             break;
@@ -843,6 +1009,7 @@ void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
             r->active_scroll_container = FindActiveScrollContainer(r, r->initial_pointer_position);
 
             if (r->active_scroll_container) {
+                Rocks_StopScroll(&r->scroll_physics, r->active_scroll_container_id);
                 r->scroll_drag_start_x = screenX;
                 r->scroll_drag_start_y = screenY;
                 r->initial_scroll_position = *r->active_scroll_container->scrollPosition;
@@ -929,6 +1096,10 @@ void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
                 Clay_SetPointerState(upPosition, false);
             }
             
+            if (r->is_scroll_dragging && r->active_scroll_container) {
+                Rocks_ReleaseScroll(&r->scroll_physics, r->active_scroll_container_id, current_time);
+            }
+
             r->current_touch_state = TOUCH_STATE_NONE;
             r->active_touch_id = 0;
             r->is_scroll_thumb_dragging = false;
@@ -966,7 +1137,83 @@ void Rocks_HandleEventSDL2(Rocks* rocks, void* event) {
     }
 }
 
+static void FlushPendingEventsSDL2(Rocks* rocks, Rocks_SDL2Renderer* r) {
+    if (r->pending_motion.type) {
+        SDL_Event motion = r->pending_motion;
+        r->pending_motion.type = 0;
+        Rocks_HandleEventSDL2(rocks, &motion);
+    }
+    if (r->pending_wheel.type) {
+        SDL_Event wheel = r->pending_wheel;
+        r->pending_wheel.type = 0;
+        Rocks_HandleEventSDL2(rocks, &wheel);
+    }
+}
+
+// Holds back motion and wheel events, keeping only the latest position and
+// the summed wheel. What is pending stays in event order: at most a motion
+// followed by a wheel at the position the motion ended on. Returns false
+// for events that have to be handled in order.
+static bool CoalesceEventSDL2(Rocks* rocks, Rocks_SDL2Renderer* r, const SDL_Event* event) {
+    switch (event->type) {
+        case SDL_MOUSEMOTION:
+            if (r->pending_wheel.type || r->pending_motion.type == SDL_FINGERMOTION) {
+                FlushPendingEventsSDL2(rocks, r);
+            }
+            r->pending_motion = *event;
+            return true;
+
+        case SDL_FINGERMOTION:
+            if (r->pending_wheel.type || r->pending_motion.type == SDL_MOUSEMOTION ||
+                (r->pending_motion.type == SDL_FINGERMOTION &&
+                 r->pending_motion.tfinger.fingerId != event->tfinger.fingerId)) {
+                FlushPendingEventsSDL2(rocks, r);
+            }
+            r->pending_motion = *event;
+            return true;
+
+        case SDL_MOUSEWHEEL:
+            if (r->pending_wheel.type &&
+                r->pending_wheel.wheel.mouseX == event->wheel.mouseX &&
+                r->pending_wheel.wheel.mouseY == event->wheel.mouseY) {
+                r->pending_wheel.wheel.x += event->wheel.x;
+                r->pending_wheel.wheel.y += event->wheel.y;
+                r->pending_wheel.wheel.preciseX += event->wheel.preciseX;
+                r->pending_wheel.wheel.preciseY += event->wheel.preciseY;
+                return true;
+            }
+            if (r->pending_wheel.type) {
+                FlushPendingEventsSDL2(rocks, r);
+            }
+            r->pending_wheel = *event;
+            return true;
+    }
+    return false;
+}
+
+// The input state holds one character and one press of each key per
+// frame, so an event that would overwrite one waits for the next frame
+static bool IsInputTakenSDL2(Rocks* rocks, const SDL_Event* event) {
+    switch (event->type) {
+        case SDL_TEXTINPUT:
+            return rocks->input.charPressed != 0;
+        case SDL_KEYDOWN:
+            // Only presses set these flags, so a release never waits
+            switch (event->key.keysym.sym) {
+                case SDLK_RETURN: return rocks->input.enterPressed;
+                case SDLK_BACKSPACE: return rocks->input.backspacePressed;
+                case SDLK_LEFT: return rocks->input.leftPressed;
+                case SDLK_RIGHT: return rocks->input.rightPressed;
+            }
+            break;
+    }
+    return false;
+}
+
 void Rocks_ProcessEventsSDL2(Rocks* rocks) {
+    Rocks_SDL2Renderer* r = rocks->renderer_data;
+    if (!r) return;
+
     // Reset input state
     rocks->input.charPressed = 0;
     rocks->input.enterPressed = false;
@@ -974,73 +1221,106 @@ void Rocks_ProcessEventsSDL2(Rocks* rocks) {
     rocks->input.leftPressed = false;
     rocks->input.rightPressed = false;
 
+    // The scroll data pointed into a Clay context that has been replaced
+    if (r->clay_generation != Rocks_GetClayGeneration()) {
+        CleanupActiveScrollContainer(r);
+        r->clay_generation = Rocks_GetClayGeneration();
+    }
+
+    // Every pointer update makes Clay hit test the whole tree, so motion and
+    // wheel bursts are merged; presses, releases and keys flush them first
+    SDL_PumpEvents();
     SDL_Event event;
-    while (SDL_PollEvent(&event)) {
+    while (SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT) > 0) {
+        if (IsInputTakenSDL2(rocks, &event)) {
+            Rocks_RequestFrame();
+            break;
+        }
+        SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+        if (CoalesceEventSDL2(rocks, r, &event)) continue;
+        FlushPendingEventsSDL2(rocks, r);
         Rocks_HandleEventSDL2(rocks, &event);
     }
-}
-void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
-    Rocks_SDL2Renderer* r = rocks->renderer_data;
-    if (!r || !r->renderer) {
-        printf("Error: Renderer or renderer data is NULL\n");
-        return;
-    }
+    FlushPendingEventsSDL2(rocks, r);
 
-    static float currentTime = 0;
-    currentTime = SDL_GetTicks() / 1000.0f;
-    
-    // Update scrollbar opacity
-    float timeSinceLastMove = currentTime - r->last_mouse_move_time;
-    if (timeSinceLastMove < SCROLLBAR_HIDE_DELAY) {
-        r->scrollbar_opacity = SDL_min(r->scrollbar_opacity + 
-            (1.0f / SCROLLBAR_FADE_DURATION) * (1.0f/60.0f), 1.0f);
-    } else {
-        r->scrollbar_opacity = SDL_max(r->scrollbar_opacity - 
-            (1.0f / SCROLLBAR_FADE_DURATION) * (1.0f/60.0f), 0.0f);
+    // Flung containers keep the loop awake until they come to rest
+    if (Rocks_StepScrollPhysics(&r->scroll_physics, Rocks_GetTimeSDL2())) {
+        Rocks_RequestFrame();
     }
+}
 
-    // Clear screen
-    SDL_SetRenderDrawColor(r->renderer, 0, 0, 0, 255);
-    SDL_RenderClear(r->renderer);
-
-    bool hasPointerElement = false;
+// Blocks until an event is queued or the timeout (seconds, negative for
+// none) runs out. The event stays queued for Rocks_ProcessEventsSDL2.
+bool Rocks_WaitEventsSDL2(float timeout) {
+    if (timeout < 0) {
+        return SDL_WaitEvent(NULL) == 1;
+    }
+    return SDL_WaitEventTimeout(NULL, (int)ceilf(timeout * 1000.0f)) == 1;
+}
 
-    // Get scaled mouse coordinates for hit testing
-    int mouseX, mouseY;
-    SDL_GetMouseState(&mouseX, &mouseY);
-    mouseX /= r->scale_factor;
-    mouseY /= r->scale_factor;
+// Draws the commands that reach `damage` (in pixels) clipped to it, or all
+// of them when it is NULL. Prepared layers stand in for their commands.
+static void DrawCommandsSDL2(Rocks_SDL2Renderer* r, Clay_RenderCommandArray commands, const SDL_Rect* damage, int mouseX, int mouseY, bool use_layers) {
+    Clay_BoundingBox area = {0};
+    SDL_RenderSetClipRect(r->renderer, damage);
+
+    if (damage) {
+        area = (Clay_BoundingBox){
+            damage->x / r->scale_factor,
+            damage->y / r->scale_factor,
+            damage->w / r->scale_factor,
+            damage->h / r->scale_factor
+        };
+    }
 
-    for (uint32_t i = 0; i < commands.length; i++) {
+    int next_layer = 0;
+    for (int32_t i = 0; i < commands.length; i++) {
         Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, i);
         if (!cmd) {
             printf("Command %d: NULL command\n", i);
             continue;
         }
+
+        if (use_layers && next_layer < r->layer_draw_count && r->layer_draws[next_layer].span.first == i) {
+            Rocks_SDL2LayerDraw* draw = &r->layer_draws[next_layer++];
+            i += draw->span.count - 1;
+            if (damage && !Rocks_DamageOverlaps(draw->span.bounds, area)) continue;
+
+            Rocks_FlushGeometryBatchSDL2(&r->batch);
+            SDL_RenderCopy(r->renderer, draw->layer->texture, NULL, &draw->rect);
+            continue;
+        }
+
+        // Scissors always apply so nested clips stay balanced
+        if (damage &&
+            cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START &&
+            cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_END &&
+            !Rocks_DamageOverlaps(Rocks_GetCommandDamageBounds(cmd), area)) {
+            continue;
+        }
+
         Clay_BoundingBox boundingBox = cmd->boundingBox;
         SDL_FRect scaledBox = ScaleBoundingBox(r->renderer, r->scale_factor, cmd->boundingBox);
 
+        // Rectangles and borders accumulate; everything else draws directly
+        // or changes the clip, so the pending geometry goes first
+        if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_RECTANGLE &&
+            cmd->commandType != CLAY_RENDER_COMMAND_TYPE_BORDER) {
+            Rocks_FlushGeometryBatchSDL2(&r->batch);
+        }
+
         switch (cmd->commandType) {
             case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
                 Clay_Color backgroundColor = cmd->renderData.rectangle.backgroundColor;
                 Clay_CornerRadius cornerRadius = cmd->renderData.rectangle.cornerRadius;
                 
-                // Check for pointer cursor and custom properties
-                RocksCustomData* customData = NULL;
-                if (cmd->userData) {
-                    customData = (RocksCustomData*)cmd->userData;
-                    if (customData->cursorPointer &&
-                        mouseX >= cmd->boundingBox.x && 
-                        mouseX <= cmd->boundingBox.x + cmd->boundingBox.width &&
-                        mouseY >= cmd->boundingBox.y && 
-                        mouseY <= cmd->boundingBox.y + cmd->boundingBox.height) {
-                        hasPointerElement = true;
-                    }
-                }
+                RocksCustomData* customData = (RocksCustomData*)cmd->userData;
 
                 // Render rounded rectangle with proper shadow support
                 RenderRoundedRectangle(
-                    r->renderer, 
+                    &r->batch,
+                    r->shadow_cache,
                     scaledBox,
                     cornerRadius,
                     backgroundColor,
@@ -1055,29 +1335,21 @@ void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
             }
             case CLAY_RENDER_COMMAND_TYPE_TEXT: {
                 if (!cmd->renderData.text.stringContents.chars || 
-                    cmd->renderData.text.stringContents.length == 0 || 
-                    cmd->renderData.text.fontId >= 32 || 
-                    !r->fonts[cmd->renderData.text.fontId].font) {
+                    cmd->renderData.text.stringContents.length == 0) {
                     continue;
                 }
 
-                // Get current clip rect
-                SDL_Rect clip;
-                SDL_RenderGetClipRect(r->renderer, &clip);
-
-                TTF_Font* font = r->fonts[cmd->renderData.text.fontId].font;
-
-                // Aligned memory allocation for text
-                size_t bufferSize = cmd->renderData.text.stringContents.length + 1;
-                char* text = (char*)SDL_AllocateAligned(8, bufferSize);
-                if (!text) {
-                    printf("Failed to allocate text buffer\n");
+                // Layout may be measuring with these fonts on another thread
+                Rocks_LockFonts();
+                Rocks_SDL2FontVariant* variant = GetFontVariantSDL2(
+                    r,
+                    cmd->renderData.text.fontId,
+                    cmd->renderData.text.fontSize
+                );
+                if (!variant) {
+                    Rocks_UnlockFonts();
                     continue;
                 }
-                
-                memset(text, 0, bufferSize);
-                memcpy(text, cmd->renderData.text.stringContents.chars, 
-                      cmd->renderData.text.stringContents.length);
 
                 SDL_Color color = {
                     cmd->renderData.text.textColor.r,
@@ -1085,34 +1357,46 @@ void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
                     cmd->renderData.text.textColor.b,
                     cmd->renderData.text.textColor.a
                 };
-                
-                SDL_Surface* surface = TTF_RenderUTF8_Blended(font, text, color);
-                if (!surface) {
-                    printf("Failed to create text surface: %s\n", TTF_GetError());
-                    SDL_FreeAligned(text);
-                    continue;
-                }
 
-                SDL_Texture* texture = SDL_CreateTextureFromSurface(r->renderer, surface);
-                if (!texture) {
-                    printf("Failed to create texture from surface: %s\n", SDL_GetError());
-                    SDL_FreeSurface(surface);
-                    SDL_FreeAligned(text);
-                    continue;
+                if (r->text_cache) {
+                    SDL_Texture* texture = Rocks_GetCachedTextSDL2(
+                        r->text_cache,
+                        r->renderer,
+                        variant->font,
+                        cmd->renderData.text.fontId,
+                        cmd->renderData.text.fontSize,
+                        cmd->renderData.text.stringContents,
+                        color
+                    );
+                    if (texture) {
+                        SDL_RenderCopyF(r->renderer, texture, NULL, &scaledBox);
+                    }
+                    Rocks_UnlockFonts();
+                    break;
                 }
-                            
-                SDL_RenderCopyF(r->renderer, texture, NULL, &scaledBox);
 
-                SDL_DestroyTexture(texture);
-                SDL_FreeSurface(surface);
-                SDL_FreeAligned(text);
+                // Created here rather than on first measure, which may not
+                // run on the thread that owns the renderer
+                if (!variant->atlas) {
+                    variant->atlas = Rocks_CreateGlyphAtlasSDL2(r->renderer, variant->font);
+                }
+                Rocks_DrawTextSDL2(
+                    r->renderer,
+                    variant->atlas,
+                    cmd->renderData.text.stringContents,
+                    scaledBox.x,
+                    scaledBox.y,
+                    r->scale_factor,
+                    color
+                );
+                Rocks_UnlockFonts();
                 break;
             }
             case CLAY_RENDER_COMMAND_TYPE_BORDER: {
                 Clay_BorderRenderData borderData = cmd->renderData.border;
                 
                 RenderBorder(
-                    r->renderer,
+                    &r->batch,
                     scaledBox,
                     (Clay_BorderElementConfig){
                         .color = borderData.color,
@@ -1129,23 +1413,16 @@ void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
             }
             
             case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START: {
-                // Track scroll container
-                if (r->scroll_container_count < 32) {
-                    r->scroll_containers[r->scroll_container_count].elementId = cmd->id;
-                    r->scroll_containers[r->scroll_container_count].openThisFrame = true;
-                    r->scroll_container_count++;
-
-                    Clay_ElementId elementId = { .id = cmd->id };
-                    Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
-                    
-                    if (scrollData.found && scrollData.config.vertical) {
-                        RenderScrollbar(r->renderer, r->rocks, boundingBox, true, mouseX, mouseY, 
-                                      &scrollData.config, elementId, r->scale_factor);
-                    }
-                    if (scrollData.found && scrollData.config.horizontal) {
-                        RenderScrollbar(r->renderer, r->rocks, boundingBox, false, mouseX, mouseY, 
-                                      &scrollData.config, elementId, r->scale_factor);
-                    }
+                Clay_ElementId elementId = { .id = cmd->id };
+                Clay_ScrollContainerData scrollData = Rocks_GetScrollContainerData(elementId);
+
+                if (scrollData.found && scrollData.config.vertical) {
+                    RenderScrollbar(r->renderer, r->rocks, boundingBox, true, mouseX, mouseY, 
+                                  &scrollData.config, elementId, r->scale_factor, r->scrollbar_opacity);
+                }
+                if (scrollData.found && scrollData.config.horizontal) {
+                    RenderScrollbar(r->renderer, r->rocks, boundingBox, false, mouseX, mouseY, 
+                                  &scrollData.config, elementId, r->scale_factor, r->scrollbar_opacity);
                 }
 
                 SDL_Rect clip = {
@@ -1154,12 +1431,17 @@ void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
                     .w = (int)(scaledBox.w),
                     .h = (int)(scaledBox.h)
                 };
+                if (damage) {
+                    SDL_Rect visible = {0};
+                    SDL_IntersectRect(&clip, damage, &visible);
+                    clip = visible;
+                }
                 SDL_RenderSetClipRect(r->renderer, &clip);
                 break;
             }
 
             case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END:
-                SDL_RenderSetClipRect(r->renderer, NULL);
+                SDL_RenderSetClipRect(r->renderer, damage);
                 break;
 
             case CLAY_RENDER_COMMAND_TYPE_IMAGE: {
@@ -1184,6 +1466,289 @@ void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
         }
     }
 
+    Rocks_FlushGeometryBatchSDL2(&r->batch);
+}
+
+// Copies a span's commands into the layer command buffer, moved by
+// (-dx, -dy). Empty when the buffer cannot grow.
+static Clay_RenderCommandArray CopyLayerCommandsSDL2(Rocks_SDL2Renderer* r, Clay_RenderCommandArray commands, const Rocks_LayerSpan* span, float dx, float dy) {
+    int32_t count = span->count;
+    if (count > r->layer_commands_capacity) {
+        Clay_RenderCommand* layer_commands = realloc(r->layer_commands, count * sizeof(Clay_RenderCommand));
+        if (!layer_commands) return (Clay_RenderCommandArray){0};
+        r->layer_commands = layer_commands;
+        r->layer_commands_capacity = count;
+    }
+
+    for (int32_t i = 0; i < count; i++) {
+        r->layer_commands[i] = *Clay_RenderCommandArray_Get(&commands, span->first + i);
+        r->layer_commands[i].boundingBox.x -= dx;
+        r->layer_commands[i].boundingBox.y -= dy;
+    }
+    return (Clay_RenderCommandArray){ .capacity = count, .length = count, .internalArray = r->layer_commands };
+}
+
+// Redraws a layer's commands into its texture, shifted so the layer's
+// top-left pixel lands on the texture origin
+static bool DrawLayerSDL2(Rocks_SDL2Renderer* r, Clay_RenderCommandArray commands, Rocks_SDL2LayerDraw* draw, int mouseX, int mouseY) {
+    float dx = draw->rect.x / r->scale_factor;
+    float dy = draw->rect.y / r->scale_factor;
+    Clay_RenderCommandArray layer_commands = CopyLayerCommandsSDL2(r, commands, &draw->span, dx, dy);
+    if (!layer_commands.length) return false;
+
+    SDL_SetRenderTarget(r->renderer, draw->layer->texture);
+    SDL_SetRenderDrawColor(r->renderer, 0, 0, 0, 0);
+    SDL_RenderClear(r->renderer);
+
+    DrawCommandsSDL2(r, layer_commands, NULL, mouseX - (int)dx, mouseY - (int)dy, false);
+
+    SDL_RenderSetClipRect(r->renderer, NULL);
+    SDL_SetRenderTarget(r->renderer, NULL);
+    return true;
+}
+
+// Brings a scroll container's texture up to date. Last frame's pixels are
+// shifted by the distance scrolled, so only the strips this uncovers and
+// children that changed are drawn again.
+static bool DrawScrollLayerSDL2(Rocks_SDL2Renderer* r, Clay_RenderCommandArray commands, Rocks_SDL2LayerDraw* draw, int mouseX, int mouseY) {
+    bool stale = false;
+    Rocks_SDL2Layer* layer = Rocks_GetScrollLayerSDL2(r->layer_cache, r->renderer, draw->span.id,
+                                                      draw->rect.w, draw->rect.h, &stale);
+    if (!layer) return false;
+    draw->layer = layer;
+
+    Clay_ScrollContainerData scrollData = Rocks_GetScrollContainerData((Clay_ElementId){ .id = draw->span.id });
+    Clay_Vector2 scroll = scrollData.found ? *scrollData.scrollPosition : (Clay_Vector2){0};
+
+    // Content is drawn as if scrolled by whole pixels, so shifted pixels
+    // line up with the strips drawn next to them
+    Clay_Vector2 offset = {
+        roundf(scroll.x * r->scale_factor),
+        roundf(scroll.y * r->scale_factor)
+    };
+    int dx = (int)(offset.x - layer->offset.x);
+    int dy = (int)(offset.y - layer->offset.y);
+
+    layer->damage.extra_hash = HashScrollbarStateSDL2;
+    layer->damage.user_data = r;
+    if (stale || abs(dx) >= layer->width || abs(dy) >= layer->height) {
+        Rocks_InvalidateDamage(&layer->damage);
+    } else if (dx || dy) {
+        if (!Rocks_ShiftScrollLayerSDL2(r->layer_cache, r->renderer, layer, dx, dy)) {
+            layer->slot.dirty = true;
+            return false;
+        }
+        Rocks_ShiftDamage(&layer->damage, (Clay_Vector2){ dx / r->scale_factor, dy / r->scale_factor });
+    }
+    layer->offset = offset;
+
+    float tx = draw->rect.x / r->scale_factor + scroll.x - offset.x / r->scale_factor;
+    float ty = draw->rect.y / r->scale_factor + scroll.y - offset.y / r->scale_factor;
+    Clay_RenderCommandArray layer_commands = CopyLayerCommandsSDL2(r, commands, &draw->span, tx, ty);
+    if (!layer_commands.length) {
+        layer->slot.dirty = true;
+        return false;
+    }
+
+    Rocks_ComputeDamage(&layer->damage, layer_commands, (Clay_Dimensions){
+        layer->width / r->scale_factor,
+        layer->height / r->scale_factor
+    });
+
+    SDL_SetRenderTarget(r->renderer, layer->texture);
+    for (int i = 0; i < layer->damage.rect_count; i++) {
+        Clay_BoundingBox rect = layer->damage.rects[i];
+        int x0 = (int)floorf(rect.x * r->scale_factor);
+        int y0 = (int)floorf(rect.y * r->scale_factor);
+        int x1 = (int)ceilf((rect.x + rect.width) * r->scale_factor);
+        int y1 = (int)ceilf((rect.y + rect.height) * r->scale_factor);
+        SDL_Rect clip = { x0, y0, x1 - x0, y1 - y0 };
+
+        SDL_RenderSetClipRect(r->renderer, &clip);
+        SDL_SetRenderDrawBlendMode(r->renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(r->renderer, 0, 0, 0, 0);
+        SDL_RenderFillRect(r->renderer, &clip);
+        SDL_SetRenderDrawBlendMode(r->renderer, SDL_BLENDMODE_BLEND);
+
+        DrawCommandsSDL2(r, layer_commands, &clip, mouseX - (int)tx, mouseY - (int)ty, false);
+    }
+    SDL_RenderSetClipRect(r->renderer, NULL);
+    SDL_SetRenderTarget(r->renderer, NULL);
+    return true;
+}
+
+// Finds the cached layers and scroll containers in this frame and brings
+// their textures up to date, before any pass targets the backbuffer
+static void PrepareLayersSDL2(Rocks_SDL2Renderer* r, Clay_RenderCommandArray commands, int mouseX, int mouseY) {
+    r->layer_draw_count = 0;
+    if (!r->layer_cache || r->backbuffer_failed) return;
+
+    Rocks_BeginLayerCacheFrameSDL2(r->layer_cache);
+
+    for (int32_t i = 0; i < commands.length && r->layer_draw_count < ROCKS_MAX_CACHED_LAYERS; i++) {
+        Rocks_SDL2LayerDraw draw = {0};
+
+        if (Rocks_FindScrollSpan(&commands, i, &draw.span)) {
+            // Same rounding the scissor uses, so the texture fills the clip
+            SDL_FRect clip = ScaleBoundingBox(r->renderer, r->scale_factor, draw.span.bounds);
+            draw.rect = (SDL_Rect){ (int)clip.x, (int)clip.y, (int)clip.w, (int)clip.h };
+
+            if (DrawScrollLayerSDL2(r, commands, &draw, mouseX, mouseY)) {
+                r->layer_draws[r->layer_draw_count++] = draw;
+                i = draw.span.first + draw.span.count - 1;
+            }
+            continue;
+        }
+
+        if (!Rocks_FindLayerSpan(&commands, i, HashScrollbarStateSDL2, r, &draw.span)) continue;
+
+        int x0 = (int)floorf(draw.span.bounds.x * r->scale_factor);
+        int y0 = (int)floorf(draw.span.bounds.y * r->scale_factor);
+        int x1 = (int)ceilf((draw.span.bounds.x + draw.span.bounds.width) * r->scale_factor);
+        int y1 = (int)ceilf((draw.span.bounds.y + draw.span.bounds.height) * r->scale_factor);
+        draw.rect = (SDL_Rect){ x0, y0, x1 - x0, y1 - y0 };
+
+        bool stale = false;
+        draw.layer = Rocks_GetLayerSDL2(r->layer_cache, r->renderer, draw.span.id, draw.span.hash,
+                                        draw.rect.w, draw.rect.h, &stale);
+        if (!draw.layer) continue;
+
+        if (stale && !DrawLayerSDL2(r, commands, &draw, mouseX, mouseY)) {
+            draw.layer->slot.dirty = true;
+            continue;
+        }
+
+        r->layer_draws[r->layer_draw_count++] = draw;
+        i += draw.span.count - 1;
+    }
+}
+
+// Recreates the backbuffer to match the output, falling back to drawing
+// straight to the window for good if render targets are unavailable
+static bool EnsureBackbufferSDL2(Rocks_SDL2Renderer* r, int width, int height) {
+    if (r->backbuffer_failed || width <= 0 || height <= 0) return false;
+    if (r->backbuffer && r->backbuffer_width == width && r->backbuffer_height == height) return true;
+
+    if (r->backbuffer) {
+        SDL_DestroyTexture(r->backbuffer);
+    }
+
+    r->backbuffer = SDL_CreateTexture(r->renderer, SDL_PIXELFORMAT_ARGB8888,
+                                      SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!r->backbuffer) {
+        printf("Failed to create backbuffer, redrawing every frame: %s\n", SDL_GetError());
+        r->backbuffer_failed = true;
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(r->backbuffer, SDL_BLENDMODE_NONE);
+    r->backbuffer_width = width;
+    r->backbuffer_height = height;
+    Rocks_InvalidateDamage(&r->damage);
+    return true;
+}
+
+void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
+    Rocks_SDL2Renderer* r = rocks->renderer_data;
+    if (!r || !r->renderer) {
+        printf("Error: Renderer or renderer data is NULL\n");
+        return;
+    }
+
+    Rocks_LockFonts();
+    DestroyRetiredAtlasesSDL2(r);
+    Rocks_UnlockFonts();
+
+    static double lastTime = 0;
+    double currentTime = Rocks_GetTimeSDL2();
+    float frameTime = lastTime > 0 ? (float)SDL_min(currentTime - lastTime, 0.1) : 0.0f;
+    lastTime = currentTime;
+    
+    // Update scrollbar opacity, at the same speed whatever the frame rate
+    float timeSinceLastMove = (float)(currentTime - r->last_mouse_move_time);
+    if (timeSinceLastMove < SCROLLBAR_HIDE_DELAY) {
+        r->scrollbar_opacity = SDL_min(r->scrollbar_opacity + 
+            (1.0f / SCROLLBAR_FADE_DURATION) * frameTime, 1.0f);
+    } else {
+        r->scrollbar_opacity = SDL_max(r->scrollbar_opacity - 
+            (1.0f / SCROLLBAR_FADE_DURATION) * frameTime, 0.0f);
+    }
+
+    // Keep drawing while the scrollbar fades, and wake up when it should hide
+    if (timeSinceLastMove < SCROLLBAR_HIDE_DELAY) {
+        if (r->scrollbar_opacity < 1.0f) {
+            Rocks_RequestFrame();
+        } else {
+            Rocks_RequestFrameIn(SCROLLBAR_HIDE_DELAY - timeSinceLastMove);
+        }
+    } else if (r->scrollbar_opacity > 0.0f) {
+        Rocks_RequestFrame();
+    }
+
+    Rocks_BeginTextCacheFrameSDL2(r->text_cache);
+    Rocks_BeginShadowCacheFrameSDL2(r->shadow_cache);
+
+    // Get scaled mouse coordinates for hit testing
+    int mouseX, mouseY;
+    SDL_GetMouseState(&mouseX, &mouseY);
+    mouseX /= r->scale_factor;
+    mouseY /= r->scale_factor;
+
+    int outputWidth, outputHeight;
+    SDL_GetRendererOutputSize(r->renderer, &outputWidth, &outputHeight);
+
+    ROCKS_PROFILE_BEGIN(track);
+    // Both look at every command, while drawing skips the ones outside
+    // the damaged areas
+    Clay_Dimensions viewport = {outputWidth / r->scale_factor, outputHeight / r->scale_factor};
+    Rocks_BuildScrollRegistry(&r->scroll_registry, commands, viewport);
+    Rocks_BuildHitIndex(&r->hit_index, commands, viewport);
+    bool hasPointerElement = Rocks_HitTest(&r->hit_index, mouseX, mouseY, ROCKS_HIT_CURSOR_POINTER) != NULL;
+    ROCKS_PROFILE_END(track);
+
+    if (EnsureBackbufferSDL2(r, outputWidth, outputHeight)) {
+        ROCKS_PROFILE_BEGIN(damage);
+        Rocks_ComputeDamage(&r->damage, commands, (Clay_Dimensions){
+            outputWidth / r->scale_factor,
+            outputHeight / r->scale_factor
+        });
+        ROCKS_PROFILE_END(damage);
+
+        ROCKS_PROFILE_BEGIN(layers);
+        PrepareLayersSDL2(r, commands, mouseX, mouseY);
+        ROCKS_PROFILE_END(layers);
+
+        ROCKS_PROFILE_BEGIN(draw);
+        SDL_SetRenderTarget(r->renderer, r->backbuffer);
+        for (int i = 0; i < r->damage.rect_count; i++) {
+            Clay_BoundingBox rect = r->damage.rects[i];
+            int x0 = (int)floorf(rect.x * r->scale_factor);
+            int y0 = (int)floorf(rect.y * r->scale_factor);
+            int x1 = (int)ceilf((rect.x + rect.width) * r->scale_factor);
+            int y1 = (int)ceilf((rect.y + rect.height) * r->scale_factor);
+            SDL_Rect clip = { x0, y0, x1 - x0, y1 - y0 };
+
+            SDL_RenderSetClipRect(r->renderer, &clip);
+            SDL_SetRenderDrawColor(r->renderer, 0, 0, 0, 255);
+            SDL_RenderFillRect(r->renderer, &clip);
+            DrawCommandsSDL2(r, commands, &clip, mouseX, mouseY, true);
+        }
+        SDL_SetRenderTarget(r->renderer, NULL);
+
+        // The window's own buffer is undefined after a present, so the whole
+        // backbuffer goes out every frame
+        SDL_RenderSetClipRect(r->renderer, NULL);
+        SDL_RenderCopy(r->renderer, r->backbuffer, NULL, NULL);
+        ROCKS_PROFILE_END(draw);
+    } else {
+        ROCKS_PROFILE_BEGIN(draw);
+        SDL_SetRenderDrawColor(r->renderer, 0, 0, 0, 255);
+        SDL_RenderClear(r->renderer);
+        DrawCommandsSDL2(r, commands, NULL, mouseX, mouseY, false);
+        SDL_RenderSetClipRect(r->renderer, NULL);
+        ROCKS_PROFILE_END(draw);
+    }
+
     // Update cursor based on hover state
     SDL_Cursor* targetCursor = hasPointerElement ? r->pointer_cursor : r->default_cursor;
     if (targetCursor != r->current_cursor) {
@@ -1191,5 +1756,9 @@ void Rocks_RenderSDL2(Rocks* rocks, Clay_RenderCommandArray commands) {
         SDL_SetCursor(r->current_cursor);
     }
 
+    Rocks_EvictTextCacheSDL2(r->text_cache, r->text_cache_max_age);
+
+    ROCKS_PROFILE_BEGIN(present);
     SDL_RenderPresent(r->renderer);
+    ROCKS_PROFILE_END(present);
 }
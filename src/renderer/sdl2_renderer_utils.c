@@ -37,37 +37,301 @@ void SDL_FreeAligned(void* ptr) {
     free(raw_memory);
 }
 
-void DrawQuarterCircle(
-    SDL_Renderer* renderer,
-    float centerX, 
-    float centerY, 
-    float radius, 
-    float startAngle,
+#define ROCKS_BATCH_MIN_CAPACITY 1024
+
+// Corner tessellation: the unit table holds the finest quarter circle and
+// coarser meshes sample it at a power-of-two stride, so no trig runs per draw
+#define ROCKS_MAX_CORNER_SEGMENTS 64
+#define ROCKS_CORNER_TOLERANCE 0.25f
+#define ROCKS_CORNER_MESH_CACHE_SIZE 64
+
+typedef struct {
+    float radius;               // On-screen radius, scale factor applied
+    int segments;
+    SDL_FPoint points[ROCKS_MAX_CORNER_SEGMENTS + 1];
+} Rocks_CornerMesh;
+
+static SDL_FPoint g_rocks_unit_corner[ROCKS_MAX_CORNER_SEGMENTS + 1];
+static bool g_rocks_unit_corner_ready = false;
+static Rocks_CornerMesh g_rocks_corner_meshes[ROCKS_CORNER_MESH_CACHE_SIZE];
+
+// Fewest power-of-two segments keeping the chord within tolerance of the arc
+static int CornerSegments(float radius) {
+    if (radius <= ROCKS_CORNER_TOLERANCE) return 1;
+
+    float step = 2.0f * acosf(1.0f - ROCKS_CORNER_TOLERANCE / radius);
+    int needed = (int)ceilf((float)(M_PI / 2.0) / step);
+
+    int segments = 1;
+    while (segments < needed && segments < ROCKS_MAX_CORNER_SEGMENTS) segments <<= 1;
+    return segments;
+}
+
+// First-quadrant offsets (0 to pi/2) for a radius, built once per radius
+static const Rocks_CornerMesh* GetCornerMesh(float radius) {
+    if (!g_rocks_unit_corner_ready) {
+        for (int i = 0; i <= ROCKS_MAX_CORNER_SEGMENTS; i++) {
+            double angle = (M_PI / 2.0) * i / ROCKS_MAX_CORNER_SEGMENTS;
+            g_rocks_unit_corner[i] = (SDL_FPoint){ (float)cos(angle), (float)sin(angle) };
+        }
+        g_rocks_unit_corner_ready = true;
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &radius, sizeof(bits));
+    Rocks_CornerMesh* mesh = &g_rocks_corner_meshes[(bits * 2654435761u) >> 26];
+    if (mesh->segments && mesh->radius == radius) return mesh;
+
+    mesh->radius = radius;
+    mesh->segments = CornerSegments(radius);
+    int stride = ROCKS_MAX_CORNER_SEGMENTS / mesh->segments;
+    for (int i = 0; i <= mesh->segments; i++) {
+        mesh->points[i].x = g_rocks_unit_corner[i * stride].x * radius;
+        mesh->points[i].y = g_rocks_unit_corner[i * stride].y * radius;
+    }
+    return mesh;
+}
+
+// Rotates a first-quadrant offset into the given corner's quadrant
+static SDL_FPoint RotateToCorner(SDL_FPoint point, Rocks_CornerQuadrant quadrant) {
+    switch (quadrant) {
+        case ROCKS_CORNER_BOTTOM_LEFT: return (SDL_FPoint){ -point.y, point.x };
+        case ROCKS_CORNER_TOP_LEFT: return (SDL_FPoint){ -point.x, -point.y };
+        case ROCKS_CORNER_TOP_RIGHT: return (SDL_FPoint){ point.y, -point.x };
+        default: return point;
+    }
+}
+
+static bool ReserveBatch(Rocks_SDL2GeometryBatch* batch, int vertices, int indices) {
+    if (batch->vertex_count + vertices > batch->vertex_capacity) {
+        int capacity = SDL_max(batch->vertex_capacity * 2, ROCKS_BATCH_MIN_CAPACITY);
+        while (capacity < batch->vertex_count + vertices) capacity *= 2;
+
+        SDL_Vertex* grown = realloc(batch->vertices, capacity * sizeof(SDL_Vertex));
+        if (!grown) return false;
+        batch->vertices = grown;
+        batch->vertex_capacity = capacity;
+    }
+
+    if (batch->index_count + indices > batch->index_capacity) {
+        int capacity = SDL_max(batch->index_capacity * 2, ROCKS_BATCH_MIN_CAPACITY * 3);
+        while (capacity < batch->index_count + indices) capacity *= 2;
+
+        int* grown = realloc(batch->indices, capacity * sizeof(int));
+        if (!grown) return false;
+        batch->indices = grown;
+        batch->index_capacity = capacity;
+    }
+
+    return true;
+}
+
+static void PushVertex(Rocks_SDL2GeometryBatch* batch, float x, float y, SDL_Color color) {
+    batch->vertices[batch->vertex_count++] = (SDL_Vertex){
+        .position = { x, y },
+        .color = color,
+        .tex_coord = batch->solid_uv
+    };
+}
+
+static void PushTexturedVertex(Rocks_SDL2GeometryBatch* batch, float x, float y, float u, float v, SDL_Color color) {
+    batch->vertices[batch->vertex_count++] = (SDL_Vertex){
+        .position = { x, y },
+        .color = color,
+        .tex_coord = { u, v }
+    };
+}
+
+static void PushTriangle(Rocks_SDL2GeometryBatch* batch, int a, int b, int c) {
+    batch->indices[batch->index_count++] = a;
+    batch->indices[batch->index_count++] = b;
+    batch->indices[batch->index_count++] = c;
+}
+
+// Starts a new run when the texture changes; call before reserving space
+static void UseBatchTexture(Rocks_SDL2GeometryBatch* batch, SDL_Texture* texture) {
+    if (batch->texture != texture) {
+        Rocks_FlushGeometryBatchSDL2(batch);
+        batch->texture = texture;
+    }
+}
+
+// Solid fills stay in the current run when its texture can supply white
+static void UseBatchSolid(Rocks_SDL2GeometryBatch* batch) {
+    if (!batch->has_solid_texel) {
+        UseBatchTexture(batch, NULL);
+    }
+}
+
+void Rocks_FlushGeometryBatchSDL2(Rocks_SDL2GeometryBatch* batch) {
+    if (batch->index_count > 0 && batch->renderer) {
+        SDL_RenderGeometry(batch->renderer, batch->texture,
+            batch->vertices, batch->vertex_count,
+            batch->indices, batch->index_count);
+    }
+    batch->vertex_count = 0;
+    batch->index_count = 0;
+
+    // The texture may be gone by the next draw
+    batch->texture = NULL;
+    batch->has_solid_texel = false;
+    batch->solid_uv = (SDL_FPoint){0};
+}
+
+void Rocks_FreeGeometryBatchSDL2(Rocks_SDL2GeometryBatch* batch) {
+    free(batch->vertices);
+    free(batch->indices);
+    memset(batch, 0, sizeof(Rocks_SDL2GeometryBatch));
+}
+
+void BatchNineSlice(
+    Rocks_SDL2GeometryBatch* batch,
+    SDL_Texture* texture,
+    SDL_FRect rect,
+    int textureSize,
+    int slice,
     SDL_Color color
 ) {
-    const int NUM_SEGMENTS = 32;
-    float angleStep = (float)(M_PI / 2.0f) / NUM_SEGMENTS;
-    
-    SDL_Vertex* verts = (SDL_Vertex*)malloc((NUM_SEGMENTS + 2) * sizeof(SDL_Vertex));
-    int numVerts = 0;
-
-    verts[numVerts].position.x = centerX;
-    verts[numVerts].position.y = centerY;
-    verts[numVerts].color = color;
-    numVerts++;
-
-    for (int i = 0; i <= NUM_SEGMENTS; i++) {
-        float angle = startAngle + (i * angleStep);
-        double precise_x = centerX + cos(angle) * radius;
-        double precise_y = centerY + sin(angle) * radius;
-        verts[numVerts].position.x = (float)precise_x;
-        verts[numVerts].position.y = (float)precise_y;
-        verts[numVerts].color = color;
-        numVerts++;
+    if (!texture || rect.w <= 0 || rect.h <= 0 || color.a == 0) return;
+
+    UseBatchTexture(batch, texture);
+    if (!ReserveBatch(batch, 16, 54)) return;
+    batch->has_solid_texel = true;
+    batch->solid_uv = (SDL_FPoint){ (slice + 0.5f) / textureSize, (slice + 0.5f) / textureSize };
+
+    // Corners shrink on elements smaller than two slices
+    float cornerW = SDL_min((float)slice, rect.w / 2);
+    float cornerH = SDL_min((float)slice, rect.h / 2);
+    float xs[4] = { rect.x, rect.x + cornerW, rect.x + rect.w - cornerW, rect.x + rect.w };
+    float ys[4] = { rect.y, rect.y + cornerH, rect.y + rect.h - cornerH, rect.y + rect.h };
+
+    // The middle band samples the center of the stretch texel
+    float middle = (slice + 0.5f) / textureSize;
+    float uvs[4] = { 0, middle, middle, 1 };
+
+    int base = batch->vertex_count;
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            PushTexturedVertex(batch, xs[col], ys[row], uvs[col], uvs[row], color);
+        }
     }
 
-    SDL_RenderGeometry(renderer, NULL, verts, numVerts, NULL, 0);
-    free(verts);
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            int topLeft = base + row * 4 + col;
+            PushTriangle(batch, topLeft, topLeft + 1, topLeft + 5);
+            PushTriangle(batch, topLeft, topLeft + 5, topLeft + 4);
+        }
+    }
+}
+
+void BatchRect(Rocks_SDL2GeometryBatch* batch, SDL_FRect rect, SDL_Color color) {
+    if (rect.w <= 0 || rect.h <= 0 || color.a == 0) return;
+
+    UseBatchSolid(batch);
+    if (!ReserveBatch(batch, 4, 6)) return;
+
+    int base = batch->vertex_count;
+    PushVertex(batch, rect.x, rect.y, color);
+    PushVertex(batch, rect.x + rect.w, rect.y, color);
+    PushVertex(batch, rect.x + rect.w, rect.y + rect.h, color);
+    PushVertex(batch, rect.x, rect.y + rect.h, color);
+    PushTriangle(batch, base, base + 1, base + 2);
+    PushTriangle(batch, base, base + 2, base + 3);
+}
+
+void BatchRoundedRect(
+    Rocks_SDL2GeometryBatch* batch,
+    SDL_FRect rect,
+    Clay_CornerRadius radii,
+    SDL_Color color
+) {
+    if (rect.w <= 0 || rect.h <= 0 || color.a == 0) return;
+
+    float maxRadius = SDL_min(rect.w, rect.h) / 2;
+    float radius[4] = {
+        SDL_clamp(radii.topLeft, 0, maxRadius),
+        SDL_clamp(radii.topRight, 0, maxRadius),
+        SDL_clamp(radii.bottomRight, 0, maxRadius),
+        SDL_clamp(radii.bottomLeft, 0, maxRadius)
+    };
+
+    if (radius[0] <= 0 && radius[1] <= 0 && radius[2] <= 0 && radius[3] <= 0) {
+        BatchRect(batch, rect, color);
+        return;
+    }
+
+    // Corner centers and quadrants, clockwise from top-left
+    float centerX[4] = {
+        rect.x + radius[0], rect.x + rect.w - radius[1],
+        rect.x + rect.w - radius[2], rect.x + radius[3]
+    };
+    float centerY[4] = {
+        rect.y + radius[0], rect.y + radius[1],
+        rect.y + rect.h - radius[2], rect.y + rect.h - radius[3]
+    };
+    const Rocks_CornerQuadrant quadrant[4] = {
+        ROCKS_CORNER_TOP_LEFT, ROCKS_CORNER_TOP_RIGHT,
+        ROCKS_CORNER_BOTTOM_RIGHT, ROCKS_CORNER_BOTTOM_LEFT
+    };
+
+    // The outline is convex, so a fan from the center covers it
+    UseBatchSolid(batch);
+    int maxVertices = 1 + 4 * (ROCKS_MAX_CORNER_SEGMENTS + 1);
+    if (!ReserveBatch(batch, maxVertices, maxVertices * 3)) return;
+
+    int center = batch->vertex_count;
+    PushVertex(batch, rect.x + rect.w / 2, rect.y + rect.h / 2, color);
+
+    for (int corner = 0; corner < 4; corner++) {
+        if (radius[corner] <= 0) {
+            PushVertex(batch, centerX[corner], centerY[corner], color);
+            continue;
+        }
+
+        const Rocks_CornerMesh* mesh = GetCornerMesh(radius[corner]);
+        for (int i = 0; i <= mesh->segments; i++) {
+            SDL_FPoint offset = RotateToCorner(mesh->points[i], quadrant[corner]);
+            PushVertex(batch, centerX[corner] + offset.x, centerY[corner] + offset.y, color);
+        }
+    }
+
+    int outline = batch->vertex_count - center - 1;
+    for (int i = 0; i < outline; i++) {
+        PushTriangle(batch, center, center + 1 + i, center + 1 + (i + 1) % outline);
+    }
+}
+
+void BatchQuarterArc(
+    Rocks_SDL2GeometryBatch* batch,
+    float centerX,
+    float centerY,
+    float outerRadius,
+    float innerRadius,
+    Rocks_CornerQuadrant quadrant,
+    SDL_Color color
+) {
+    if (outerRadius <= 0 || color.a == 0) return;
+    innerRadius = SDL_clamp(innerRadius, 0, outerRadius);
+
+    const Rocks_CornerMesh* mesh = GetCornerMesh(outerRadius);
+    UseBatchSolid(batch);
+    if (!ReserveBatch(batch, (mesh->segments + 1) * 2, mesh->segments * 6)) return;
+
+    // Strip of outer/inner vertex pairs; a zero inner radius degenerates to a fan
+    int base = batch->vertex_count;
+    float innerRatio = innerRadius / outerRadius;
+    for (int i = 0; i <= mesh->segments; i++) {
+        SDL_FPoint offset = RotateToCorner(mesh->points[i], quadrant);
+        PushVertex(batch, centerX + offset.x, centerY + offset.y, color);
+        PushVertex(batch, centerX + offset.x * innerRatio, centerY + offset.y * innerRatio, color);
+    }
+
+    for (int i = 0; i < mesh->segments; i++) {
+        int outer = base + i * 2;
+        PushTriangle(batch, outer, outer + 2, outer + 1);
+        PushTriangle(batch, outer + 1, outer + 2, outer + 3);
+    }
 }
 
 SDL_FRect ScaleBoundingBox(SDL_Renderer* renderer, float scale_factor, Clay_BoundingBox box) {
@@ -80,7 +344,8 @@ SDL_FRect ScaleBoundingBox(SDL_Renderer* renderer, float scale_factor, Clay_Boun
 }
 
 void RenderRoundedRectangle(
-    SDL_Renderer* renderer,
+    Rocks_SDL2GeometryBatch* batch,
+    Rocks_SDL2ShadowCache* shadows,
     SDL_FRect rect,
     Clay_CornerRadius cornerRadius,
     Clay_Color color,
@@ -92,33 +357,36 @@ void RenderRoundedRectangle(
     float scale_factor
 ) {
     if (shadowEnabled) {
-        SDL_FRect shadowRect = {
-            .x = rect.x + shadowOffset.x - shadowBlurRadius - shadowSpread,
-            .y = rect.y + shadowOffset.y - shadowBlurRadius - shadowSpread,
-            .w = rect.w + (shadowBlurRadius + shadowSpread) * 2,
-            .h = rect.h + (shadowBlurRadius + shadowSpread) * 2
-        };
-
-        roundedBoxRGBA(renderer,
-            shadowRect.x,
-            shadowRect.y,
-            shadowRect.x + shadowRect.w,
-            shadowRect.y + shadowRect.h,
-            cornerRadius.topLeft * scale_factor,
-            shadowColor.r, shadowColor.g, shadowColor.b, shadowColor.a);
+        const Rocks_SDL2Shadow* shadow = Rocks_GetShadowSDL2(
+            shadows, batch->renderer, cornerRadius, shadowBlurRadius, shadowSpread, scale_factor);
+
+        if (shadow) {
+            float extent = shadowSpread * scale_factor + shadow->pad;
+            SDL_FRect shadowRect = {
+                .x = rect.x + shadowOffset.x * scale_factor - extent,
+                .y = rect.y + shadowOffset.y * scale_factor - extent,
+                .w = rect.w + extent * 2,
+                .h = rect.h + extent * 2
+            };
+
+            BatchNineSlice(batch, shadow->texture, shadowRect, shadow->size, shadow->slice,
+                (SDL_Color){ shadowColor.r, shadowColor.g, shadowColor.b, shadowColor.a });
+        }
     }
 
-    roundedBoxRGBA(renderer,
-        rect.x,
-        rect.y,
-        rect.x + rect.w,
-        rect.y + rect.h,
+    Clay_CornerRadius scaledRadius = {
         cornerRadius.topLeft * scale_factor,
-        color.r, color.g, color.b, color.a);
+        cornerRadius.topRight * scale_factor,
+        cornerRadius.bottomLeft * scale_factor,
+        cornerRadius.bottomRight * scale_factor
+    };
+
+    BatchRoundedRect(batch, rect, scaledRadius,
+        (SDL_Color){ color.r, color.g, color.b, color.a });
 }
 
 void RenderBorder(
-    SDL_Renderer* renderer,
+    Rocks_SDL2GeometryBatch* batch,
     SDL_FRect rect,
     Clay_BorderElementConfig border,
     Clay_CornerRadius cornerRadius,
@@ -135,8 +403,6 @@ void RenderBorder(
         .a = border.color.a
     };
 
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-
     // Top border
     if (isTop && border.width.top > 0) {
         float scaledWidth = border.width.top * scale_factor;
@@ -146,26 +412,28 @@ void RenderBorder(
             rect.w - ((cornerRadius.topLeft + cornerRadius.topRight) * scale_factor),
             scaledWidth
         };
-        SDL_RenderFillRectF(renderer, &topRect);
+        BatchRect(batch, topRect, color);
 
         if (cornerRadius.topLeft > 0) {
-            DrawQuarterCircle(
-                renderer,
+            BatchQuarterArc(
+                batch,
                 rect.x + (cornerRadius.topLeft * scale_factor),
                 rect.y + (cornerRadius.topLeft * scale_factor),
                 cornerRadius.topLeft * scale_factor,
-                M_PI,
+                (cornerRadius.topLeft - border.width.top) * scale_factor,
+                ROCKS_CORNER_TOP_LEFT,
                 color
             );
         }
 
         if (cornerRadius.topRight > 0) {
-            DrawQuarterCircle(
-                renderer,
+            BatchQuarterArc(
+                batch,
                 rect.x + rect.w - (cornerRadius.topRight * scale_factor),
                 rect.y + (cornerRadius.topRight * scale_factor),
                 cornerRadius.topRight * scale_factor,
-                -M_PI/2,
+                (cornerRadius.topRight - border.width.top) * scale_factor,
+                ROCKS_CORNER_TOP_RIGHT,
                 color
             );
         }
@@ -180,26 +448,28 @@ void RenderBorder(
             rect.w - ((cornerRadius.bottomLeft + cornerRadius.bottomRight) * scale_factor),
             scaledWidth
         };
-        SDL_RenderFillRectF(renderer, &bottomRect);
+        BatchRect(batch, bottomRect, color);
 
         if (cornerRadius.bottomLeft > 0) {
-            DrawQuarterCircle(
-                renderer,
+            BatchQuarterArc(
+                batch,
                 rect.x + (cornerRadius.bottomLeft * scale_factor),
                 rect.y + rect.h - (cornerRadius.bottomLeft * scale_factor),
                 cornerRadius.bottomLeft * scale_factor,
-                M_PI/2,
+                (cornerRadius.bottomLeft - border.width.bottom) * scale_factor,
+                ROCKS_CORNER_BOTTOM_LEFT,
                 color
             );
         }
 
         if (cornerRadius.bottomRight > 0) {
-            DrawQuarterCircle(
-                renderer,
+            BatchQuarterArc(
+                batch,
                 rect.x + rect.w - (cornerRadius.bottomRight * scale_factor),
                 rect.y + rect.h - (cornerRadius.bottomRight * scale_factor),
                 cornerRadius.bottomRight * scale_factor,
-                0,
+                (cornerRadius.bottomRight - border.width.bottom) * scale_factor,
+                ROCKS_CORNER_BOTTOM_RIGHT,
                 color
             );
         }
@@ -214,7 +484,7 @@ void RenderBorder(
             scaledWidth,
             rect.h - ((cornerRadius.topLeft + cornerRadius.bottomLeft) * scale_factor)
         };
-        SDL_RenderFillRectF(renderer, &leftRect);
+        BatchRect(batch, leftRect, color);
     }
 
     // Right border
@@ -226,18 +496,17 @@ void RenderBorder(
             scaledWidth,
             rect.h - ((cornerRadius.topRight + cornerRadius.bottomRight) * scale_factor)
         };
-        SDL_RenderFillRectF(renderer, &rightRect);
+        BatchRect(batch, rightRect, color);
     }
 
     // Between children border
     if (border.width.betweenChildren > 0) {
-        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-        SDL_RenderFillRectF(renderer, &(SDL_FRect){
+        BatchRect(batch, (SDL_FRect){
             rect.x,
             rect.y + rect.h - (border.width.betweenChildren * scale_factor),
             rect.w,
             border.width.betweenChildren * scale_factor
-        });
+        }, color);
     }
 }
 
@@ -260,9 +529,12 @@ void RenderScrollbar(
     int mouseY,
     Clay_ScrollElementConfig *config,
     Clay_ElementId elementId,
-    float scale_factor
+    float scale_factor,
+    float opacity
 ) {
-    Clay_ScrollContainerData scrollData = Clay_GetScrollContainerData(elementId);
+    if (opacity <= 0.0f) return;
+
+    Clay_ScrollContainerData scrollData = Rocks_GetScrollContainerData(elementId);
     if (!scrollData.found) return;
 
     // Get theme colors from rocks global instance
@@ -315,10 +587,13 @@ void RenderScrollbar(
         scaledMouseX >= thumb.x && scaledMouseX <= thumb.x + thumb.w &&
         scaledMouseY >= thumb.y && scaledMouseY <= thumb.y + thumb.h;
 
-    // Render track
-    RenderScrollbarRect(renderer, track, theme.scrollbar_track);
+    // Render track, faded in and out with pointer activity
+    Clay_Color trackColor = theme.scrollbar_track;
+    trackColor.a *= opacity;
+    RenderScrollbarRect(renderer, track, trackColor);
 
     // Render thumb
     Clay_Color thumbColor = isHovered ? theme.scrollbar_thumb_hover : theme.scrollbar_thumb;
+    thumbColor.a *= opacity;
     RenderScrollbarRect(renderer, thumb, thumbColor);
 }
\ No newline at end of file
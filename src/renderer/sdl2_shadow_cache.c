@@ -0,0 +1,232 @@
+#include "renderer/sdl2_shadow_cache.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Three box passes approximate a Gaussian (CSS uses sigma = blur / 2)
+#define ROCKS_SHADOW_BOX_PASSES 3
+
+static void GaussianBoxRadii(float sigma, int radii[ROCKS_SHADOW_BOX_PASSES]) {
+    const int n = ROCKS_SHADOW_BOX_PASSES;
+    float ideal = sqrtf(12.0f * sigma * sigma / n + 1.0f);
+    int lower = (int)floorf(ideal);
+    if (lower % 2 == 0) lower--;
+    int upper = lower + 2;
+
+    float m = (12.0f * sigma * sigma - n * lower * lower - 4.0f * n * lower - 3.0f * n) /
+              (-4.0f * lower - 4.0f);
+    int lower_count = (int)roundf(m);
+
+    for (int i = 0; i < n; i++) {
+        int width = i < lower_count ? lower : upper;
+        radii[i] = (width - 1) / 2;
+    }
+}
+
+// Running-sum box blur down the columns. The inner loops walk whole rows,
+// so every column advances together and the compiler can vectorize them.
+static void BoxBlurColumns(const float* src, float* dst, float* sum, int size, int radius) {
+    if (radius <= 0) {
+        memcpy(dst, src, (size_t)size * size * sizeof(float));
+        return;
+    }
+
+    float scale = 1.0f / (2 * radius + 1);
+    memset(sum, 0, size * sizeof(float));
+
+    for (int y = 0; y < radius && y < size; y++) {
+        const float* row = src + (size_t)y * size;
+        for (int x = 0; x < size; x++) sum[x] += row[x];
+    }
+
+    for (int y = 0; y < size; y++) {
+        if (y + radius < size) {
+            const float* add = src + (size_t)(y + radius) * size;
+            for (int x = 0; x < size; x++) sum[x] += add[x];
+        }
+
+        float* out = dst + (size_t)y * size;
+        for (int x = 0; x < size; x++) out[x] = sum[x] * scale;
+
+        if (y - radius >= 0) {
+            const float* sub = src + (size_t)(y - radius) * size;
+            for (int x = 0; x < size; x++) sum[x] -= sub[x];
+        }
+    }
+}
+
+static void Transpose(const float* src, float* dst, int size) {
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            dst[(size_t)x * size + y] = src[(size_t)y * size + x];
+        }
+    }
+}
+
+// Anti-aliased coverage of a pixel center; radii in Clay_CornerRadius order
+static float RoundedRectCoverage(float px, float py, float x0, float y0, float x1, float y1, const float radius[4]) {
+    float r, cx, cy;
+    if (px < x0 + radius[0] && py < y0 + radius[0]) {
+        r = radius[0]; cx = x0 + r; cy = y0 + r;
+    } else if (px > x1 - radius[1] && py < y0 + radius[1]) {
+        r = radius[1]; cx = x1 - r; cy = y0 + r;
+    } else if (px < x0 + radius[2] && py > y1 - radius[2]) {
+        r = radius[2]; cx = x0 + r; cy = y1 - r;
+    } else if (px > x1 - radius[3] && py > y1 - radius[3]) {
+        r = radius[3]; cx = x1 - r; cy = y1 - r;
+    } else {
+        float inside = fminf(fminf(px - x0, x1 - px), fminf(py - y0, y1 - py));
+        return fminf(fmaxf(inside + 0.5f, 0.0f), 1.0f);
+    }
+
+    float dx = px - cx;
+    float dy = py - cy;
+    return fminf(fmaxf(r - sqrtf(dx * dx + dy * dy) + 0.5f, 0.0f), 1.0f);
+}
+
+static bool BuildShadow(Rocks_SDL2Shadow* shadow, SDL_Renderer* renderer) {
+    float scale = shadow->scale;
+    float spread = shadow->spread * scale;
+    float radius[4] = {
+        fmaxf(shadow->radius.topLeft * scale + spread, 0.0f),
+        fmaxf(shadow->radius.topRight * scale + spread, 0.0f),
+        fmaxf(shadow->radius.bottomLeft * scale + spread, 0.0f),
+        fmaxf(shadow->radius.bottomRight * scale + spread, 0.0f)
+    };
+    float max_radius = fmaxf(fmaxf(radius[0], radius[1]), fmaxf(radius[2], radius[3]));
+
+    int box_radii[ROCKS_SHADOW_BOX_PASSES];
+    GaussianBoxRadii(fmaxf(shadow->blur * scale, 0.0f) / 2.0f, box_radii);
+
+    int pad = 0;
+    for (int i = 0; i < ROCKS_SHADOW_BOX_PASSES; i++) pad += box_radii[i];
+
+    // Corners take radius plus the blur reach on both sides of the edge,
+    // leaving the texel at `slice` untouched by either corner
+    int slice = (int)ceilf(max_radius) + 2 * pad;
+    int size = 2 * slice + 1;
+    size_t count = (size_t)size * size;
+
+    float* a = malloc(count * sizeof(float));
+    float* b = malloc(count * sizeof(float));
+    float* sum = malloc(size * sizeof(float));
+    uint32_t* pixels = malloc(count * sizeof(uint32_t));
+    if (!a || !b || !sum || !pixels) {
+        free(a);
+        free(b);
+        free(sum);
+        free(pixels);
+        return false;
+    }
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            a[(size_t)y * size + x] = RoundedRectCoverage(
+                x + 0.5f, y + 0.5f, pad, pad, size - pad, size - pad, radius);
+        }
+    }
+
+    // Separable blur: columns, transpose, columns again, transpose back
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < ROCKS_SHADOW_BOX_PASSES; i++) {
+            BoxBlurColumns(a, b, sum, size, box_radii[i]);
+            float* swap = a; a = b; b = swap;
+        }
+        Transpose(a, b, size);
+        float* swap = a; a = b; b = swap;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        float alpha = fminf(fmaxf(a[i], 0.0f), 1.0f);
+        pixels[i] = ((uint32_t)(alpha * 255.0f + 0.5f) << 24) | 0x00FFFFFF;
+    }
+
+    // The stretch texel lies past every corner's blur, so it is fully
+    // covered; pin it against rounding since solid fills sample it too
+    pixels[(size_t)slice * size + slice] = 0xFFFFFFFF;
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                             SDL_TEXTUREACCESS_STATIC, size, size);
+    if (texture) {
+        SDL_UpdateTexture(texture, NULL, pixels, size * sizeof(uint32_t));
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    } else {
+        printf("Failed to create shadow texture: %s\n", SDL_GetError());
+    }
+
+    free(a);
+    free(b);
+    free(sum);
+    free(pixels);
+
+    shadow->texture = texture;
+    shadow->size = size;
+    shadow->slice = slice;
+    shadow->pad = pad;
+    return texture != NULL;
+}
+
+Rocks_SDL2ShadowCache* Rocks_CreateShadowCacheSDL2(void) {
+    return calloc(1, sizeof(Rocks_SDL2ShadowCache));
+}
+
+void Rocks_DestroyShadowCacheSDL2(Rocks_SDL2ShadowCache* cache) {
+    if (!cache) return;
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->entries[i].texture) {
+            SDL_DestroyTexture(cache->entries[i].texture);
+        }
+    }
+    free(cache);
+}
+
+void Rocks_BeginShadowCacheFrameSDL2(Rocks_SDL2ShadowCache* cache) {
+    if (cache) cache->frame++;
+}
+
+const Rocks_SDL2Shadow* Rocks_GetShadowSDL2(
+    Rocks_SDL2ShadowCache* cache,
+    SDL_Renderer* renderer,
+    Clay_CornerRadius radius,
+    float blur,
+    float spread,
+    float scale
+) {
+    if (!cache || !renderer) return NULL;
+
+    Rocks_SDL2Shadow* victim = NULL;
+    for (int i = 0; i < cache->count; i++) {
+        Rocks_SDL2Shadow* entry = &cache->entries[i];
+        if (entry->blur == blur && entry->spread == spread && entry->scale == scale &&
+            memcmp(&entry->radius, &radius, sizeof(Clay_CornerRadius)) == 0) {
+            entry->last_used_frame = cache->frame;
+            return entry;
+        }
+        if (!victim || entry->last_used_frame < victim->last_used_frame) {
+            victim = entry;
+        }
+    }
+
+    if (cache->count < ROCKS_SHADOW_CACHE_SIZE) {
+        victim = &cache->entries[cache->count++];
+    } else if (victim->last_used_frame == cache->frame) {
+        return NULL;
+    } else if (victim->texture) {
+        SDL_DestroyTexture(victim->texture);
+    }
+
+    *victim = (Rocks_SDL2Shadow){
+        .radius = radius,
+        .blur = blur,
+        .spread = spread,
+        .scale = scale,
+        .last_used_frame = cache->frame
+    };
+
+    if (!BuildShadow(victim, renderer)) {
+        // Keep the slot keyed so a failing shadow is not rebuilt every draw
+        victim->texture = NULL;
+    }
+    return victim->texture ? victim : NULL;
+}
@@ -0,0 +1,224 @@
+#include "renderer/sdl2_text_cache.h"
+#include "rocks_profile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROCKS_TEXT_CACHE_INITIAL_BUCKETS 256
+
+static uint64_t HashText(Clay_StringSlice text, uint16_t font_id, uint16_t font_size, SDL_Color color) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (int32_t i = 0; i < text.length; i++) {
+        hash ^= (unsigned char)text.chars[i];
+        hash *= 1099511628211ULL;
+    }
+
+    uint64_t extra = ((uint64_t)font_size << 48) | ((uint64_t)font_id << 32) |
+                     ((uint64_t)color.r << 24) | ((uint64_t)color.g << 16) |
+                     ((uint64_t)color.b << 8) | (uint64_t)color.a;
+    for (int i = 0; i < 8; i++) {
+        hash ^= (extra >> (i * 8)) & 0xFF;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void UnlinkLRU(Rocks_SDL2TextCache* cache, Rocks_SDL2TextCacheEntry* entry) {
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache->lru_head = entry->next;
+
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache->lru_tail = entry->prev;
+
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void PushLRU(Rocks_SDL2TextCache* cache, Rocks_SDL2TextCacheEntry* entry) {
+    entry->prev = NULL;
+    entry->next = cache->lru_head;
+    if (cache->lru_head) cache->lru_head->prev = entry;
+    cache->lru_head = entry;
+    if (!cache->lru_tail) cache->lru_tail = entry;
+}
+
+static void RemoveEntry(Rocks_SDL2TextCache* cache, Rocks_SDL2TextCacheEntry* entry) {
+    Rocks_SDL2TextCacheEntry** link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while (*link && *link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    if (*link) *link = entry->bucket_next;
+
+    UnlinkLRU(cache, entry);
+
+    cache->bytes_used -= entry->bytes;
+    cache->entry_count--;
+
+    if (entry->texture) SDL_DestroyTexture(entry->texture);
+    free(entry->text);
+    free(entry);
+}
+
+static void GrowBuckets(Rocks_SDL2TextCache* cache) {
+    int bucket_count = cache->bucket_count * 2;
+    Rocks_SDL2TextCacheEntry** buckets = calloc(bucket_count, sizeof(Rocks_SDL2TextCacheEntry*));
+    if (!buckets) return;
+
+    for (int i = 0; i < cache->bucket_count; i++) {
+        Rocks_SDL2TextCacheEntry* entry = cache->buckets[i];
+        while (entry) {
+            Rocks_SDL2TextCacheEntry* next = entry->bucket_next;
+            Rocks_SDL2TextCacheEntry** bucket = &buckets[entry->hash & (bucket_count - 1)];
+            entry->bucket_next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = bucket_count;
+}
+
+Rocks_SDL2TextCache* Rocks_CreateTextCacheSDL2(size_t byte_budget) {
+    Rocks_SDL2TextCache* cache = calloc(1, sizeof(Rocks_SDL2TextCache));
+    if (!cache) return NULL;
+
+    cache->bucket_count = ROCKS_TEXT_CACHE_INITIAL_BUCKETS;
+    cache->buckets = calloc(cache->bucket_count, sizeof(Rocks_SDL2TextCacheEntry*));
+    if (!cache->buckets) {
+        free(cache);
+        return NULL;
+    }
+
+    cache->byte_budget = byte_budget;
+    return cache;
+}
+
+void Rocks_DestroyTextCacheSDL2(Rocks_SDL2TextCache* cache) {
+    if (!cache) return;
+
+    while (cache->lru_head) {
+        RemoveEntry(cache, cache->lru_head);
+    }
+
+    free(cache->buckets);
+    free(cache);
+}
+
+void Rocks_BeginTextCacheFrameSDL2(Rocks_SDL2TextCache* cache) {
+    if (!cache) return;
+    cache->frame++;
+}
+
+void Rocks_EvictTextCacheSDL2(Rocks_SDL2TextCache* cache, uint64_t max_age) {
+    if (!cache) return;
+
+    // The tail is always the least recently used entry
+    while (cache->lru_tail && cache->frame - cache->lru_tail->last_used_frame > max_age) {
+        RemoveEntry(cache, cache->lru_tail);
+    }
+}
+
+void Rocks_InvalidateTextCacheFontSDL2(Rocks_SDL2TextCache* cache, uint16_t font_id) {
+    if (!cache) return;
+
+    Rocks_SDL2TextCacheEntry* entry = cache->lru_head;
+    while (entry) {
+        Rocks_SDL2TextCacheEntry* next = entry->next;
+        if (entry->font_id == font_id) {
+            RemoveEntry(cache, entry);
+        }
+        entry = next;
+    }
+}
+
+SDL_Texture* Rocks_GetCachedTextSDL2(
+    Rocks_SDL2TextCache* cache,
+    SDL_Renderer* renderer,
+    TTF_Font* font,
+    uint16_t font_id,
+    uint16_t font_size,
+    Clay_StringSlice text,
+    SDL_Color color
+) {
+    if (!cache || !renderer || !font || !text.chars || text.length <= 0) return NULL;
+
+    uint64_t hash = HashText(text, font_id, font_size, color);
+    Rocks_SDL2TextCacheEntry** bucket = &cache->buckets[hash & (cache->bucket_count - 1)];
+
+    for (Rocks_SDL2TextCacheEntry* entry = *bucket; entry; entry = entry->bucket_next) {
+        if (entry->hash == hash &&
+            entry->length == text.length &&
+            entry->font_id == font_id &&
+            entry->font_size == font_size &&
+            memcmp(&entry->color, &color, sizeof(SDL_Color)) == 0 &&
+            memcmp(entry->text, text.chars, text.length) == 0) {
+            entry->last_used_frame = cache->frame;
+            UnlinkLRU(cache, entry);
+            PushLRU(cache, entry);
+            return entry->texture;
+        }
+    }
+
+    Rocks_SDL2TextCacheEntry* entry = calloc(1, sizeof(Rocks_SDL2TextCacheEntry));
+    if (!entry) return NULL;
+
+    entry->text = malloc(text.length + 1);
+    if (!entry->text) {
+        free(entry);
+        return NULL;
+    }
+    memcpy(entry->text, text.chars, text.length);
+    entry->text[text.length] = '\0';
+
+    ROCKS_PROFILE_BEGIN(text_raster);
+    SDL_Surface* surface = TTF_RenderUTF8_Blended(font, entry->text, color);
+    ROCKS_PROFILE_END(text_raster);
+    if (!surface) {
+        printf("Failed to create text surface: %s\n", TTF_GetError());
+        free(entry->text);
+        free(entry);
+        return NULL;
+    }
+
+    ROCKS_PROFILE_BEGIN(text_upload);
+    entry->texture = SDL_CreateTextureFromSurface(renderer, surface);
+    ROCKS_PROFILE_END(text_upload);
+    entry->width = surface->w;
+    entry->height = surface->h;
+    SDL_FreeSurface(surface);
+
+    if (!entry->texture) {
+        printf("Failed to create texture from surface: %s\n", SDL_GetError());
+        free(entry->text);
+        free(entry);
+        return NULL;
+    }
+
+    entry->hash = hash;
+    entry->length = text.length;
+    entry->font_id = font_id;
+    entry->font_size = font_size;
+    entry->color = color;
+    entry->bytes = (size_t)entry->width * entry->height * 4;
+    entry->last_used_frame = cache->frame;
+
+    if ((cache->entry_count + 1) * 4 > cache->bucket_count * 3) {
+        GrowBuckets(cache);
+        bucket = &cache->buckets[hash & (cache->bucket_count - 1)];
+    }
+
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    PushLRU(cache, entry);
+    cache->entry_count++;
+    cache->bytes_used += entry->bytes;
+
+    // Keep the new entry even if it alone exceeds the budget
+    while (cache->bytes_used > cache->byte_budget && cache->lru_tail != entry) {
+        RemoveEntry(cache, cache->lru_tail);
+    }
+
+    return entry->texture;
+}
@@ -4,13 +4,168 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdatomic.h>
 #include <time.h>
 #include "rocks_custom.h"
+#include "rocks_frame_pacer.h"
+#include "rocks_measure_cache.h"
+#include "rocks_pipeline.h"
+#include "rocks_profile.h"
 #include "components/modal.h"
 
 // Define the global Rocks instance
 Rocks* GRocks = NULL;
 Rocks_Modal* GActiveModal = NULL;
+
+static Rocks_FramePacer g_rocks_frame_pacer;
+
+#define ROCKS_CLAY_MAX_GROW_ATTEMPTS 4
+
+// Capacity Clay ran out of during the current layout
+#define ROCKS_CLAY_OVERFLOW_ARENA (1 << 0)
+#define ROCKS_CLAY_OVERFLOW_ELEMENTS (1 << 1)
+#define ROCKS_CLAY_OVERFLOW_TEXT (1 << 2)
+
+static Rocks_LayoutStats g_rocks_layout_stats;
+static uint32_t g_rocks_clay_overflow = 0;
+static uint32_t g_rocks_clay_generation = 0;
+static atomic_uint_fast64_t g_rocks_frame_index = 0;
+static uint32_t g_rocks_clay_errors_seen = 0;     // One bit per Clay_ErrorType already printed
+
+static void HandleClayError(Clay_ErrorData error) {
+    switch (error.errorType) {
+        case CLAY_ERROR_TYPE_ARENA_CAPACITY_EXCEEDED:
+            g_rocks_clay_overflow |= ROCKS_CLAY_OVERFLOW_ARENA;
+            break;
+        case CLAY_ERROR_TYPE_ELEMENTS_CAPACITY_EXCEEDED:
+            g_rocks_clay_overflow |= ROCKS_CLAY_OVERFLOW_ELEMENTS;
+            break;
+        case CLAY_ERROR_TYPE_TEXT_MEASUREMENT_CAPACITY_EXCEEDED:
+            g_rocks_clay_overflow |= ROCKS_CLAY_OVERFLOW_TEXT;
+            break;
+        default:
+            break;
+    }
+
+    // Most errors repeat every frame, so each kind is printed once
+    uint32_t bit = 1u << error.errorType;
+    if (g_rocks_clay_errors_seen & bit) return;
+    g_rocks_clay_errors_seen |= bit;
+    printf("Clay error: %.*s\n", error.errorText.length, error.errorText.chars);
+}
+
+static Clay_ErrorHandler ClayErrorHandler(void) {
+    return (Clay_ErrorHandler){ .errorHandlerFunction = HandleClayError };
+}
+
+static void RecordLayoutUsage(void) {
+    int32_t elements = Rocks_GetClayElementCount();
+    int32_t words = Rocks_GetClayMeasuredWordCount();
+    if (elements > g_rocks_layout_stats.peak_element_count) g_rocks_layout_stats.peak_element_count = elements;
+    if (words > g_rocks_layout_stats.peak_text_word_count) g_rocks_layout_stats.peak_text_word_count = words;
+}
+
+// Scroll positions of the frame that overflowed, held across GrowClay so
+// the new context does not snap every container back to the top
+static Rocks_ScrollSnapshot* g_rocks_saved_scrolls = NULL;
+static int32_t g_rocks_saved_scroll_count = 0;
+
+static void DropSavedScrollPositions(void) {
+    free(g_rocks_saved_scrolls);
+    g_rocks_saved_scrolls = NULL;
+    g_rocks_saved_scroll_count = 0;
+}
+
+static void SaveScrollPositions(Clay_RenderCommandArray commands) {
+    int32_t count = 0;
+    for (int32_t i = 0; i < commands.length; i++) {
+        if (Clay_RenderCommandArray_Get(&commands, i)->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) count++;
+    }
+
+    DropSavedScrollPositions();
+    g_rocks_saved_scrolls = count > 0 ? malloc(count * sizeof(Rocks_ScrollSnapshot)) : NULL;
+    if (!g_rocks_saved_scrolls) return;
+
+    for (int32_t i = 0; i < commands.length; i++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, i);
+        if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) continue;
+
+        Clay_ScrollContainerData data = Clay_GetScrollContainerData((Clay_ElementId){ .id = cmd->id });
+        if (!data.found) continue;
+
+        Rocks_ScrollSnapshot* scroll = &g_rocks_saved_scrolls[g_rocks_saved_scroll_count++];
+        scroll->id = cmd->id;
+        scroll->position = *data.scrollPosition;
+    }
+}
+
+// Clay applies scroll positions while ending a layout, so the restored
+// ones show from the next frame on
+static void RestoreScrollPositions(void) {
+    for (int32_t i = 0; i < g_rocks_saved_scroll_count; i++) {
+        Clay_ScrollContainerData data = Clay_GetScrollContainerData((Clay_ElementId){ .id = g_rocks_saved_scrolls[i].id });
+        if (data.found) *data.scrollPosition = g_rocks_saved_scrolls[i].position;
+    }
+    if (g_rocks_saved_scroll_count > 0) Rocks_RequestFrame();
+}
+
+// Restarts Clay in a larger arena, doubling whichever capacity ran out.
+// The old context's layout and pointer state go with it; LayOutFrame
+// carries the scroll positions over.
+static bool GrowClay(Rocks* rocks) {
+    int32_t elements = Clay_GetMaxElementCount();
+    int32_t words = Clay_GetMaxMeasureTextCacheWordCount();
+
+    // Clay sizes its next layout from the live context's counts
+    Clay_SetMaxElementCount(g_rocks_clay_overflow & ROCKS_CLAY_OVERFLOW_ELEMENTS ? elements * 2 : elements);
+    Clay_SetMaxMeasureTextCacheWordCount(g_rocks_clay_overflow & ROCKS_CLAY_OVERFLOW_TEXT ? words * 2 : words);
+    size_t size = Clay_MinMemorySize();
+
+    void* memory = NULL;
+    if (rocks->config.max_arena_size == 0 || size <= rocks->config.max_arena_size) {
+        memory = malloc(size);
+    }
+    if (!memory) {
+        printf("Could not grow the Clay arena to %zu bytes\n", size);
+        Clay_SetMaxElementCount(elements);
+        Clay_SetMaxMeasureTextCacheWordCount(words);
+        return false;
+    }
+
+    void* old_memory = rocks->clay_arena.memory;
+    rocks->clay_arena = Clay_CreateArenaWithCapacityAndMemory(size, memory);
+    Clay_Initialize(rocks->clay_arena,
+        (Clay_Dimensions){
+            rocks->config.window_width * rocks->global_scaling_factor,
+            rocks->config.window_height * rocks->global_scaling_factor
+        },
+        ClayErrorHandler()
+    );
+
+    // Clay_Initialize has moved on to the new context, so nothing reads the
+    // old memory past this point
+    free(old_memory);
+    rocks->config.arena_size = size;
+
+    // The measure function's user data lives in the context
+    Rocks_SetMeasureTextFunction(g_rocks_measure_cache.measure, g_rocks_measure_cache.user_data);
+
+    // A fresh context would see a held or released button as a new press or
+    // release; two updates settle it into its steady state
+    Clay_Vector2 pointer = { rocks->input.mousePositionX, rocks->input.mousePositionY };
+    bool down = rocks->input.isMouseDown || rocks->input.isTouchDown;
+    Clay_SetPointerState(pointer, down);
+    Clay_SetPointerState(pointer, down);
+
+    g_rocks_clay_generation++;
+    g_rocks_layout_stats.grow_count++;
+    g_rocks_layout_stats.arena_size = size;
+    g_rocks_layout_stats.max_element_count = Clay_GetMaxElementCount();
+    g_rocks_layout_stats.max_text_word_count = Clay_GetMaxMeasureTextCacheWordCount();
+    printf("Grew the Clay arena to %zu bytes for %d elements and %d measured words\n",
+        size, g_rocks_layout_stats.max_element_count, g_rocks_layout_stats.max_text_word_count);
+    return true;
+}
 void Rocks_HandleGlobalModalClick(Clay_ElementId elementId, Clay_PointerData pointerInfo, intptr_t userData) {
     if (pointerInfo.state == CLAY_POINTER_DATA_PRESSED_THIS_FRAME && GActiveModal) {
         Rocks_CloseModal(GActiveModal);
@@ -27,8 +182,9 @@ static void BeginFrame(Rocks* rocks) {
         (Clay_Vector2){rocks->input.mousePositionX, rocks->input.mousePositionY},
         rocks->input.isMouseDown || rocks->input.isTouchDown
     );
+    Rocks_BeginMeasureCacheFrame();
     Clay_BeginLayout();
-    g_rocks_frame_arena.offset = 0;
+    Rocks_ResetFrameArena(Rocks_GetFrameArena());
 
     // Add a root container that will handle global clicks
     CLAY({
@@ -63,24 +219,40 @@ Rocks* Rocks_Init(Rocks_Config config) {
         static Rocks_RaylibConfig default_config = {};
         rocks->config.renderer_config = &default_config;
     }
+
+    // Loading a font size uploads its atlas from inside text measurement,
+    // which needs the GL context's thread
+    if (rocks->config.pipelined) {
+        printf("The raylib backend lays out and draws frames on one thread\n");
+        rocks->config.pipelined = false;
+    }
     #endif
 
+    // With no context yet these set the capacity the first one is made with
+    if (rocks->config.max_element_count > 0) {
+        Clay_SetMaxElementCount(rocks->config.max_element_count);
+    }
+    if (rocks->config.max_text_word_count > 0) {
+        Clay_SetMaxMeasureTextCacheWordCount(rocks->config.max_text_word_count);
+    }
+
+    size_t min_arena_size = Clay_MinMemorySize();
     if (rocks->config.arena_size == 0) {
-        rocks->config.arena_size = DEFAULT_ARENA_SIZE;
+        rocks->config.arena_size = min_arena_size;
+    } else if (rocks->config.arena_size < min_arena_size) {
+        printf("Raising the Clay arena from %zu to the %zu bytes Clay needs\n",
+            rocks->config.arena_size, min_arena_size);
+        rocks->config.arena_size = min_arena_size;
     }
 
     void* arena_memory = malloc(rocks->config.arena_size);
-
-
-    size_t customArenaSize = 1024 * 1024; // 1MB for custom data
-    g_rocks_frame_arena.memory = malloc(customArenaSize);
-    if (!g_rocks_frame_arena.memory) {
-        free(g_rocks_frame_arena.memory);
-        g_rocks_frame_arena = (RocksArena){0};
+    if (!arena_memory) {
+        free(rocks);
+        return NULL;
     }
 
-
-    if (!arena_memory) {
+    if (!Rocks_InitFrameArena(&g_rocks_frame_arena, ROCKS_FRAME_ARENA_BLOCK_SIZE)) {
+        free(arena_memory);
         free(rocks);
         return NULL;
     }
@@ -90,19 +262,28 @@ Rocks* Rocks_Init(Rocks_Config config) {
         arena_memory
     );
 
-    Clay_ErrorHandler error_handler = {0};
+    g_rocks_clay_overflow = 0;
+    g_rocks_clay_errors_seen = 0;
     Clay_Initialize(rocks->clay_arena, 
         (Clay_Dimensions){ 
             config.window_width * rocks->global_scaling_factor,
             config.window_height * rocks->global_scaling_factor
         },
-        error_handler
+        ClayErrorHandler()
     );
+    g_rocks_layout_stats = (Rocks_LayoutStats){
+        .arena_size = rocks->config.arena_size,
+        .max_element_count = Clay_GetMaxElementCount(),
+        .max_text_word_count = Clay_GetMaxMeasureTextCacheWordCount()
+    };
 
     Clay_SetCurrentContext(Clay_GetCurrentContext());
 
+    Rocks_InitMeasureCache(ROCKS_MEASURE_CACHE_CAPACITY);
+
 #ifdef ROCKS_USE_SDL2
     if (!Rocks_InitSDL2(rocks, rocks->config.renderer_config)) {
+        Rocks_FreeFrameArena(&g_rocks_frame_arena);
         free(rocks->clay_arena.memory);
         free(rocks);
         return NULL;
@@ -116,6 +297,16 @@ Rocks* Rocks_Init(Rocks_Config config) {
         raylib_config->scale_factor = rocks->global_scaling_factor;
     }
     if (!Rocks_InitRaylib(rocks, rocks->config.renderer_config)) {
+        Rocks_FreeFrameArena(&g_rocks_frame_arena);
+        free(rocks->clay_arena.memory);
+        free(rocks);
+        return NULL;
+    }
+#endif
+
+#ifdef ROCKS_USE_HEADLESS
+    if (!Rocks_InitHeadless(rocks, rocks->config.renderer_config)) {
+        Rocks_FreeFrameArena(&g_rocks_frame_arena);
         free(rocks->clay_arena.memory);
         free(rocks);
         return NULL;
@@ -123,6 +314,31 @@ Rocks* Rocks_Init(Rocks_Config config) {
 #endif
 
     GRocks = rocks;
+
+    float refresh_rate = 0.0f;
+    bool vsync = false;
+#ifdef ROCKS_USE_SDL2
+    refresh_rate = Rocks_GetRefreshRateSDL2(rocks);
+    Rocks_ConfigSDL2* sdl_config = (Rocks_ConfigSDL2*)rocks->config.renderer_config;
+    vsync = sdl_config && (sdl_config->vsync || (sdl_config->renderer_flags & SDL_RENDERER_PRESENTVSYNC));
+#endif
+#ifdef ROCKS_USE_RAYLIB
+    refresh_rate = Rocks_GetRefreshRateRaylib();
+    vsync = raylib_config && raylib_config->vsync;
+#endif
+
+    // Presenting already waits for the display, which is the rate a fixed
+    // pacer would follow anyway
+    Rocks_FramePacing pacing = config.frame_pacing;
+    if (vsync && pacing == ROCKS_FRAME_PACING_FIXED && config.target_fps <= 0) {
+        pacing = ROCKS_FRAME_PACING_VSYNC;
+    }
+#ifdef ROCKS_USE_HEADLESS
+    // The fake clock only moves between frames, so waiting on it never ends
+    pacing = ROCKS_FRAME_PACING_UNCAPPED;
+#endif
+    Rocks_InitFramePacer(&g_rocks_frame_pacer, pacing, config.target_fps, refresh_rate);
+
     return rocks;
 }
 
@@ -137,6 +353,10 @@ void Rocks_SetWindowSize(Rocks* rocks, int width, int height) {
     Rocks_SetWindowSizeRaylib(rocks, width, height);
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+    Rocks_SetWindowSizeHeadless(rocks, width, height);
+#endif
+
     rocks->config.window_width = width;
     rocks->config.window_height = height;
 }
@@ -164,9 +384,14 @@ void Rocks_Cleanup(Rocks* rocks) {
     Rocks_CleanupRaylib(rocks);
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+    Rocks_CleanupHeadless(rocks);
+#endif
+
 
-    free(g_rocks_frame_arena.memory);
-    g_rocks_frame_arena = (RocksArena){0};
+    Rocks_FreeFrameArena(&g_rocks_frame_arena);
+
+    Rocks_CleanupMeasureCache();
 
     free(rocks->clay_arena.memory);
     free(rocks);
@@ -185,53 +410,309 @@ void Rocks_StopTextInput(void) {
     #endif
 }
 
-void Rocks_Run(Rocks* rocks, Rocks_UpdateFunction update) {
-    float last_time = Rocks_GetTime(rocks);
+// Pending frame requests for idle mode. The first frame always draws.
+// Requests may come from the layout thread while a frame is drawn.
+static atomic_bool g_rocks_frame_requested = true;
+static _Atomic double g_rocks_frame_deadline = 0.0;    // 0 when no timed frame is pending
+static bool g_rocks_event_waiting = false;     // raylib sleeps at the end of the last frame
+
+void Rocks_RequestFrame(void) {
+    g_rocks_frame_requested = true;
+}
+
+void Rocks_RequestFrameIn(float seconds) {
+    if (!GRocks) return;
+    if (seconds <= 0) {
+        g_rocks_frame_requested = true;
+        return;
+    }
+
+    double deadline = Rocks_GetTime(GRocks) + seconds;
+    double pending = g_rocks_frame_deadline;
+    while ((pending == 0.0 || deadline < pending) &&
+           !atomic_compare_exchange_weak(&g_rocks_frame_deadline, &pending, deadline)) {
+    }
+}
+
+static bool IsFrameDue(Rocks* rocks) {
+    double deadline = g_rocks_frame_deadline;
+    return g_rocks_frame_requested || (deadline > 0.0 && Rocks_GetTime(rocks) >= deadline);
+}
+
+// Sleeps until input arrives or a requested frame is due, then consumes the
+// requests the coming frame satisfies. Returns true when woken by input.
+static bool WaitForFrame(Rocks* rocks) {
+    bool woke_on_input = false;
+
+#ifdef ROCKS_USE_SDL2
+    if (!g_rocks_frame_requested) {
+        float timeout = -1.0f;
+        if (g_rocks_frame_deadline > 0.0) {
+            timeout = (float)(g_rocks_frame_deadline - Rocks_GetTime(rocks));
+        }
+        if (g_rocks_frame_deadline == 0.0 || timeout > 0.0f) {
+            woke_on_input = Rocks_WaitEventsSDL2(timeout);
+        }
+    }
+#endif
+
+#ifdef ROCKS_USE_RAYLIB
+    woke_on_input = g_rocks_event_waiting;
+#endif
+
+    g_rocks_frame_requested = false;
+    if (g_rocks_frame_deadline > 0.0 && Rocks_GetTime(rocks) >= g_rocks_frame_deadline) {
+        g_rocks_frame_deadline = 0.0;
+    }
+    return woke_on_input;
+}
+
+static void ProcessEvents(Rocks* rocks) {
+    ROCKS_PROFILE_BEGIN(events);
+    #ifdef ROCKS_USE_SDL2
+        Rocks_ProcessEventsSDL2(rocks);
+    #endif
+
+    #ifdef ROCKS_USE_RAYLIB
+        Rocks_ProcessEventsRaylib(rocks);
+    #endif
+
+    #ifdef ROCKS_USE_HEADLESS
+        Rocks_ProcessEventsHeadless(rocks);
+    #endif
+    ROCKS_PROFILE_END(events);
+}
+
+static Clay_RenderCommandArray LayOutFrame(Rocks* rocks, Rocks_UpdateFunction update) {
+    Clay_RenderCommandArray commands;
+    bool grew = false;
+    atomic_fetch_add(&g_rocks_frame_index, 1);
+
+    for (int attempt = 0; ; attempt++) {
+        g_rocks_clay_overflow = 0;
+
+        ROCKS_PROFILE_BEGIN(begin_frame);
+        BeginFrame(rocks);
+        ROCKS_PROFILE_END(begin_frame);
+
+        // The update function ends the layout, so this covers Clay too
+        ROCKS_PROFILE_BEGIN(update_layout);
+        commands = update(rocks, rocks->input.deltaTime);
+        ROCKS_PROFILE_END(update_layout);
+
+        RecordLayoutUsage();
+        if (!g_rocks_clay_overflow) break;
+
+        g_rocks_layout_stats.overflow_count++;
+        if (!rocks->config.auto_grow_arena || attempt == ROCKS_CLAY_MAX_GROW_ATTEMPTS) break;
+
+        // A second grow would only find the first one's fresh positions
+        if (!grew) SaveScrollPositions(commands);
+        if (!GrowClay(rocks)) break;
+        grew = true;
+
+        // The first pass already acted on this frame's keys and wheel, and
+        // advanced its animations and timers
+        rocks->input.deltaTime = 0;
+        rocks->input.charPressed = 0;
+        rocks->input.enterPressed = false;
+        rocks->input.backspacePressed = false;
+        rocks->input.leftPressed = false;
+        rocks->input.rightPressed = false;
+        rocks->input.scrollDeltaX = 0;
+        rocks->input.scrollDeltaY = 0;
+    }
+
+    if (grew) RestoreScrollPositions();
+    DropSavedScrollPositions();
+    return commands;
+}
+
+static void RenderFrame(Rocks* rocks, Clay_RenderCommandArray commands) {
+    ROCKS_PROFILE_BEGIN(render);
+
+    #ifdef ROCKS_USE_SDL2
+        Rocks_RenderSDL2(rocks, commands);
+    #endif
+
+    #ifdef ROCKS_USE_RAYLIB
+        // raylib has no timed wait, so a pending deadline keeps the
+        // regular frame pacing until it expires
+        if (rocks->config.idle_mode) {
+            g_rocks_event_waiting = !g_rocks_frame_requested && g_rocks_frame_deadline == 0.0f;
+            Rocks_SetEventWaitingRaylib(g_rocks_event_waiting);
+        }
+        Rocks_RenderRaylib(rocks, commands);
+    #endif
+
+    #ifdef ROCKS_USE_HEADLESS
+        Rocks_RenderHeadless(rocks, commands);
+    #endif
+    ROCKS_PROFILE_END(render);
+}
+
+static void RunSerial(Rocks* rocks, Rocks_UpdateFunction update) {
+    double last_time = Rocks_GetTime(rocks);
 
     while (rocks->is_running) {
-        float current_time = Rocks_GetTime(rocks);
-        rocks->input.deltaTime = current_time - last_time;
+        ROCKS_PROFILE_BEGIN(idle);
+        if (rocks->config.idle_mode && WaitForFrame(rocks)) {
+            // Clay reports hover and release changes a frame late, so input
+            // gets one follow-up frame to settle
+            Rocks_RequestFrame();
+        }
+        ROCKS_PROFILE_END(idle);
+
+        ROCKS_PROFILE_BEGIN(frame);
+        double current_time = Rocks_GetTime(rocks);
+        rocks->input.deltaTime = (float)(current_time - last_time);
         last_time = current_time;
+        Rocks_BeginPacedFrame(&g_rocks_frame_pacer, current_time);
 
-        #ifdef ROCKS_USE_SDL2
-            Rocks_ProcessEventsSDL2(rocks);
-        #endif
+        ProcessEvents(rocks);
+        Clay_RenderCommandArray commands = LayOutFrame(rocks, update);
+        RenderFrame(rocks, commands);
 
-        #ifdef ROCKS_USE_RAYLIB
-            Rocks_ProcessEventsRaylib(rocks);
-        #endif
+        ROCKS_PROFILE_BEGIN(pace);
+        Rocks_EndPacedFrame(&g_rocks_frame_pacer);
+        ROCKS_PROFILE_END(pace);
+        ROCKS_PROFILE_END(frame);
+    }
+}
 
-        BeginFrame(rocks);
+typedef struct {
+    Rocks* rocks;
+    Rocks_UpdateFunction update;
+    Rocks_PipelineFrame* target;
+    bool captured;
+} Rocks_LayoutJob;
+
+static void RunLayoutJob(void* userData) {
+    Rocks_LayoutJob* job = userData;
+
+    // Frame data has to outlive the layout thread's next frame
+    Rocks_SetFrameArena(&job->target->arena);
+    Clay_RenderCommandArray commands = LayOutFrame(job->rocks, job->update);
+
+    ROCKS_PROFILE_BEGIN(capture);
+    job->target->theme = job->rocks->config.theme;
+    job->captured = Rocks_CaptureFrame(job->target, commands);
+    ROCKS_PROFILE_END(capture);
+}
+
+// Lays out each frame on a worker thread while the previous one is drawn.
+// Events are handled between the two, while the worker is idle, since
+// both touch Clay's state.
+static void RunPipelined(Rocks* rocks, Rocks_UpdateFunction update) {
+    Rocks_PipelineFrame frames[2];
+    bool ready = Rocks_InitPipelineFrame(&frames[0], ROCKS_FRAME_ARENA_BLOCK_SIZE);
+    ready = Rocks_InitPipelineFrame(&frames[1], ROCKS_FRAME_ARENA_BLOCK_SIZE) && ready;
+
+    Rocks_LayoutJob job = { .rocks = rocks, .update = update };
+    if (!ready || !Rocks_StartPipeline(RunLayoutJob, &job)) {
+        printf("Falling back to laying out and drawing frames on one thread\n");
+        Rocks_FreePipelineFrame(&frames[0]);
+        Rocks_FreePipelineFrame(&frames[1]);
+        RunSerial(rocks, update);
+        return;
+    }
+
+    Rocks_PipelineFrame* pending = NULL;     // Laid out, waiting to be drawn
+    int next = 0;
+    double last_time = Rocks_GetTime(rocks);
+
+    while (rocks->is_running) {
+        // A frame still in the pipeline goes out before the loop sleeps,
+        // without laying out another behind it
+        bool lay_out = true;
+        ROCKS_PROFILE_BEGIN(idle);
+        if (rocks->config.idle_mode) {
+            if (pending && !IsFrameDue(rocks)) {
+                lay_out = false;
+            } else if (WaitForFrame(rocks)) {
+                Rocks_RequestFrame();
+            }
+        }
+        ROCKS_PROFILE_END(idle);
+
+        ROCKS_PROFILE_BEGIN(frame);
+        double current_time = Rocks_GetTime(rocks);
+        rocks->input.deltaTime = (float)(current_time - last_time);
+        last_time = current_time;
+        Rocks_BeginPacedFrame(&g_rocks_frame_pacer, current_time);
+
+        if (lay_out) {
+            ProcessEvents(rocks);
+            job.target = &frames[next];
+            Rocks_KickPipeline();
+        }
+
+        if (pending) {
+            Rocks_SetDrawnFrame(pending);
+            RenderFrame(rocks, Rocks_GetFrameCommands(pending));
+            Rocks_SetDrawnFrame(NULL);
+            pending = NULL;
+        }
+
+        if (lay_out) {
+            ROCKS_PROFILE_BEGIN(layout_wait);
+            Rocks_WaitPipeline();
+            ROCKS_PROFILE_END(layout_wait);
+            if (job.captured) {
+                pending = &frames[next];
+                next = !next;
+            }
+        }
 
-        Clay_RenderCommandArray commands = update(rocks, rocks->input.deltaTime);
+        ROCKS_PROFILE_BEGIN(pace);
+        Rocks_EndPacedFrame(&g_rocks_frame_pacer);
+        ROCKS_PROFILE_END(pace);
+        ROCKS_PROFILE_END(frame);
+    }
 
-        #ifdef ROCKS_USE_SDL2
-            Rocks_RenderSDL2(rocks, commands);
-        #endif
+    Rocks_StopPipeline();
+    Rocks_SetFrameArena(NULL);
+    Rocks_FreePipelineFrame(&frames[0]);
+    Rocks_FreePipelineFrame(&frames[1]);
+}
 
-        #ifdef ROCKS_USE_RAYLIB
-            Rocks_RenderRaylib(rocks, commands);
-        #endif
+void Rocks_Run(Rocks* rocks, Rocks_UpdateFunction update) {
+    if (rocks->config.pipelined) {
+        RunPipelined(rocks, update);
+    } else {
+        RunSerial(rocks, update);
     }
 }
 
 uint16_t Rocks_LoadFont(const char* path, int size, uint16_t expected_id) {
     if (!GRocks) return UINT16_MAX;
 
+    uint16_t font_id = UINT16_MAX;
+    Rocks_LockFonts();
+
 #ifdef ROCKS_USE_SDL2
-    return Rocks_LoadFontSDL2(GRocks, path, size, expected_id);
+    font_id = Rocks_LoadFontSDL2(GRocks, path, size, expected_id);
 #endif
 
 #ifdef ROCKS_USE_RAYLIB
-    return Rocks_LoadFontRaylib(GRocks, path, size, expected_id);
+    font_id = Rocks_LoadFontRaylib(GRocks, path, size, expected_id);
 #endif
 
-    return UINT16_MAX;
+#ifdef ROCKS_USE_HEADLESS
+    font_id = Rocks_LoadFontHeadless(GRocks, path, size, expected_id);
+#endif
+
+    // Cached measurements may belong to a font previously loaded under this id
+    Rocks_ClearMeasureCache();
+    Rocks_UnlockFonts();
+    return font_id;
 }
 
 void Rocks_UnloadFont(uint16_t font_id) {
     if (!GRocks) return;
 
+    Rocks_LockFonts();
+
 #ifdef ROCKS_USE_SDL2
     Rocks_UnloadFontSDL2(GRocks, font_id);
 #endif
@@ -239,6 +720,13 @@ void Rocks_UnloadFont(uint16_t font_id) {
 #ifdef ROCKS_USE_RAYLIB
     Rocks_UnloadFontRaylib(GRocks, font_id);
 #endif
+
+#ifdef ROCKS_USE_HEADLESS
+    Rocks_UnloadFontHeadless(GRocks, font_id);
+#endif
+
+    Rocks_ClearMeasureCache();
+    Rocks_UnlockFonts();
 }
 
 static Clay_Color MakeColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
@@ -273,9 +761,34 @@ void Rocks_SetTheme(Rocks* rocks, Rocks_Theme theme) {
 }
 
 Rocks_Theme Rocks_GetTheme(Rocks* rocks) {
+    // Drawing a pipelined frame uses the theme it was laid out with
+    const Rocks_PipelineFrame* drawn = Rocks_GetDrawnFrame();
+    if (drawn) return drawn->theme;
     return rocks->config.theme;
 }
 
+Rocks_LayoutStats Rocks_GetLayoutStats(void) {
+    return g_rocks_layout_stats;
+}
+
+uint32_t Rocks_GetClayGeneration(void) {
+    return g_rocks_clay_generation;
+}
+
+uint64_t Rocks_GetFrameIndex(void) {
+    return atomic_load(&g_rocks_frame_index);
+}
+
+Clay_ScrollContainerData Rocks_GetScrollContainerData(Clay_ElementId id) {
+    const Rocks_PipelineFrame* drawn = Rocks_GetDrawnFrame();
+    if (!drawn) return Clay_GetScrollContainerData(id);
+
+    for (int32_t i = 0; i < drawn->scroll_count; i++) {
+        if (drawn->scrolls[i].id == id.id) return drawn->scrolls[i].data;
+    }
+    return (Clay_ScrollContainerData){0};
+}
+
 void* Rocks_LoadImage(Rocks* rocks, const char* path) {
     if (!rocks) return NULL;
 
@@ -287,6 +800,10 @@ void* Rocks_LoadImage(Rocks* rocks, const char* path) {
     return Rocks_LoadImageRaylib(rocks, path);
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+    return Rocks_LoadImageHeadless(rocks, path);
+#endif
+
     // For HTML renderer we'd return the path itself
     return (void*)path;
 }
@@ -302,6 +819,10 @@ void* Rocks_LoadImageFromMemory(Rocks* rocks, const char* data, size_t length) {
     return Rocks_LoadImageFromMemoryRaylib(rocks, data, length);
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+    return Rocks_LoadImageFromMemoryHeadless(rocks, data, length);
+#endif
+
     return NULL;
 }
 
@@ -315,6 +836,10 @@ void Rocks_UnloadImage(Rocks* rocks, void* image_data) {
 #ifdef ROCKS_USE_RAYLIB
     Rocks_UnloadImageRaylib(rocks, image_data);
 #endif
+
+#ifdef ROCKS_USE_HEADLESS
+    Rocks_UnloadImageHeadless(rocks, image_data);
+#endif
 }
 
 Clay_Dimensions Rocks_GetImageDimensions(Rocks* rocks, void* image_data) {
@@ -328,23 +853,35 @@ Clay_Dimensions Rocks_GetImageDimensions(Rocks* rocks, void* image_data) {
     return Rocks_GetImageDimensionsRaylib(rocks, image_data);
 #endif
 
+#ifdef ROCKS_USE_HEADLESS
+    return Rocks_GetImageDimensionsHeadless(rocks, image_data);
+#endif
+
     return (Clay_Dimensions){0, 0};
 }
 
-float Rocks_GetTime(Rocks* rocks) {
+double Rocks_GetTime(Rocks* rocks) {
     #ifdef ROCKS_USE_SDL2
-        return SDL_GetTicks() / 1000.0f;
+        return Rocks_GetTimeSDL2();
     #endif
 
     #ifdef ROCKS_USE_RAYLIB
         return Rocks_GetTimeRaylib();
     #endif
 
+    #ifdef ROCKS_USE_HEADLESS
+        return Rocks_GetTimeHeadless(rocks);
+    #else
+        (void)rocks;
+    #endif
+
     #ifdef __EMSCRIPTEN__
         // For WASM/Emscripten
-        return emscripten_get_now() / 1000.0f;
+        return emscripten_get_now() / 1000.0;
     #endif
 
-    // Default fallback using standard C
-    return (float)clock() / CLOCKS_PER_SEC;
-}
\ No newline at end of file
+    // Default fallback using the standard monotonic clock
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
@@ -0,0 +1,117 @@
+#include "rocks_arena.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+Rocks_FrameArena g_rocks_frame_arena = {0};
+
+static Rocks_FrameArena* g_rocks_active_frame_arena = NULL;
+
+static Rocks_ArenaBlock* CreateBlock(size_t size) {
+    Rocks_ArenaBlock* block = malloc(sizeof(Rocks_ArenaBlock) + size);
+    if (!block) return NULL;
+
+    block->next = NULL;
+    block->size = size;
+    block->offset = 0;
+    return block;
+}
+
+static void* AllocFromBlock(Rocks_ArenaBlock* block, size_t size, size_t align) {
+    uintptr_t base = (uintptr_t)(block + 1);
+    uintptr_t start = (base + block->offset + (align - 1)) & ~(uintptr_t)(align - 1);
+    if (start + size > base + block->size) return NULL;
+
+    block->offset = start + size - base;
+    return (void*)start;
+}
+
+bool Rocks_InitFrameArena(Rocks_FrameArena* arena, size_t block_size) {
+    *arena = (Rocks_FrameArena){ .block_size = block_size };
+
+    arena->first = CreateBlock(block_size);
+    if (!arena->first) {
+        printf("Failed to allocate a %zu byte frame arena\n", block_size);
+        return false;
+    }
+    arena->current = arena->first;
+    arena->capacity = block_size;
+    arena->block_count = 1;
+    return true;
+}
+
+void Rocks_FreeFrameArena(Rocks_FrameArena* arena) {
+    Rocks_ArenaBlock* block = arena->first;
+    while (block) {
+        Rocks_ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    *arena = (Rocks_FrameArena){0};
+}
+
+void Rocks_ResetFrameArena(Rocks_FrameArena* arena) {
+    for (Rocks_ArenaBlock* block = arena->first; block; block = block->next) {
+        block->offset = 0;
+    }
+    arena->current = arena->first;
+    arena->used = 0;
+}
+
+void* Rocks_ArenaAlloc(Rocks_FrameArena* arena, size_t size, size_t align) {
+    if (align == 0) align = alignof(max_align_t);
+    if (align & (align - 1)) {
+        printf("Frame arena alignment %zu is not a power of two\n", align);
+        return NULL;
+    }
+
+    // Blocks further down the chain are empty this frame, so the first one
+    // that fits is used and any smaller ones are skipped
+    Rocks_ArenaBlock* last = arena->current;
+    for (Rocks_ArenaBlock* block = arena->current; block; block = block->next) {
+        size_t before = block->offset;
+        void* memory = AllocFromBlock(block, size, align);
+        if (memory) {
+            arena->current = block;
+            arena->used += block->offset - before;
+            if (arena->used > arena->high_water) arena->high_water = arena->used;
+            return memory;
+        }
+        last = block;
+    }
+
+    size_t grown = last ? last->size * 2 : arena->block_size;
+    if (grown < size + align) grown = size + align;
+
+    Rocks_ArenaBlock* block = CreateBlock(grown);
+    if (!block) {
+        arena->overflows++;
+        printf("Frame arena overflow: %zu bytes requested with %zu of %zu in use\n",
+            size, arena->used, arena->capacity);
+        return NULL;
+    }
+    if (last) {
+        last->next = block;
+    } else {
+        arena->first = block;
+    }
+    arena->capacity += grown;
+    arena->block_count++;
+
+    void* memory = AllocFromBlock(block, size, align);
+    arena->current = block;
+    arena->used += block->offset;
+    if (arena->used > arena->high_water) arena->high_water = arena->used;
+    return memory;
+}
+
+void* Rocks_FrameAlloc(size_t size, size_t align) {
+    return Rocks_ArenaAlloc(Rocks_GetFrameArena(), size, align);
+}
+
+void Rocks_SetFrameArena(Rocks_FrameArena* arena) {
+    g_rocks_active_frame_arena = arena;
+}
+
+Rocks_FrameArena* Rocks_GetFrameArena(void) {
+    return g_rocks_active_frame_arena ? g_rocks_active_frame_arena : &g_rocks_frame_arena;
+}
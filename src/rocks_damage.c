@@ -0,0 +1,411 @@
+#include "rocks_damage.h"
+#include "rocks_custom.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Past this share of the viewport a single full redraw is cheaper than
+// clipping every pass
+#define ROCKS_DAMAGE_FULL_RATIO 0.5f
+
+// Extra margin for anti-aliased edges and glyph overhang
+#define ROCKS_DAMAGE_FRINGE 2.0f
+
+// Positions closer than this draw the same pixels. Content moved by scroll
+// offsets carries float noise that would otherwise count as movement.
+#define ROCKS_DAMAGE_EPSILON 0.01f
+
+uint64_t Rocks_DamageHash(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#define HASH_FIELD(hash, field) Rocks_DamageHash((hash), &(field), sizeof(field))
+
+uint64_t Rocks_HashRenderCommand(const Clay_RenderCommand* cmd) {
+    uint64_t hash = ROCKS_DAMAGE_HASH_SEED;
+    const Clay_RenderData* data = &cmd->renderData;
+
+    switch (cmd->commandType) {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE: {
+            hash = HASH_FIELD(hash, data->rectangle.backgroundColor);
+            hash = HASH_FIELD(hash, data->rectangle.cornerRadius);
+
+            const RocksCustomData* custom = cmd->userData;
+            if (custom && custom->shadowEnabled) {
+                hash = HASH_FIELD(hash, custom->shadowColor);
+                hash = HASH_FIELD(hash, custom->shadowOffset);
+                hash = HASH_FIELD(hash, custom->shadowBlurRadius);
+                hash = HASH_FIELD(hash, custom->shadowSpread);
+            }
+            break;
+        }
+        case CLAY_RENDER_COMMAND_TYPE_BORDER:
+            hash = HASH_FIELD(hash, data->border.color);
+            hash = HASH_FIELD(hash, data->border.cornerRadius);
+            hash = HASH_FIELD(hash, data->border.width);
+            break;
+        case CLAY_RENDER_COMMAND_TYPE_TEXT:
+            if (data->text.stringContents.chars && data->text.stringContents.length > 0) {
+                hash = Rocks_DamageHash(hash, data->text.stringContents.chars, data->text.stringContents.length);
+            }
+            hash = HASH_FIELD(hash, data->text.textColor);
+            hash = HASH_FIELD(hash, data->text.fontId);
+            hash = HASH_FIELD(hash, data->text.fontSize);
+            hash = HASH_FIELD(hash, data->text.letterSpacing);
+            hash = HASH_FIELD(hash, data->text.lineHeight);
+            break;
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE:
+            hash = HASH_FIELD(hash, data->image.backgroundColor);
+            hash = HASH_FIELD(hash, data->image.cornerRadius);
+            hash = HASH_FIELD(hash, data->image.imageData);
+            break;
+        case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
+            hash = HASH_FIELD(hash, data->scroll.horizontal);
+            hash = HASH_FIELD(hash, data->scroll.vertical);
+            break;
+        case CLAY_RENDER_COMMAND_TYPE_CUSTOM:
+            hash = HASH_FIELD(hash, data->custom.backgroundColor);
+            hash = HASH_FIELD(hash, data->custom.cornerRadius);
+            hash = HASH_FIELD(hash, data->custom.customData);
+            break;
+        default:
+            break;
+    }
+    return hash;
+}
+
+static uint64_t HashCommand(const Rocks_DamageTracker* tracker, const Clay_RenderCommand* cmd) {
+    uint64_t hash = Rocks_HashRenderCommand(cmd);
+    if (tracker->extra_hash) {
+        uint64_t extra = tracker->extra_hash(cmd, tracker->user_data);
+        hash = HASH_FIELD(hash, extra);
+    }
+    return hash;
+}
+
+static Clay_BoundingBox UnionBox(Clay_BoundingBox a, Clay_BoundingBox b) {
+    float x0 = fminf(a.x, b.x);
+    float y0 = fminf(a.y, b.y);
+    float x1 = fmaxf(a.x + a.width, b.x + b.width);
+    float y1 = fmaxf(a.y + a.height, b.y + b.height);
+    return (Clay_BoundingBox){x0, y0, x1 - x0, y1 - y0};
+}
+
+Clay_BoundingBox Rocks_IntersectBox(Clay_BoundingBox a, Clay_BoundingBox b) {
+    float x0 = fmaxf(a.x, b.x);
+    float y0 = fmaxf(a.y, b.y);
+    float x1 = fminf(a.x + a.width, b.x + b.width);
+    float y1 = fminf(a.y + a.height, b.y + b.height);
+    if (x1 <= x0 || y1 <= y0) return (Clay_BoundingBox){0};
+    return (Clay_BoundingBox){x0, y0, x1 - x0, y1 - y0};
+}
+
+static bool IsEmptyBox(Clay_BoundingBox box) {
+    return box.width <= 0 || box.height <= 0;
+}
+
+static bool SameBox(Clay_BoundingBox a, Clay_BoundingBox b) {
+    return fabsf(a.x - b.x) < ROCKS_DAMAGE_EPSILON &&
+           fabsf(a.y - b.y) < ROCKS_DAMAGE_EPSILON &&
+           fabsf(a.width - b.width) < ROCKS_DAMAGE_EPSILON &&
+           fabsf(a.height - b.height) < ROCKS_DAMAGE_EPSILON;
+}
+
+bool Rocks_DamageOverlaps(Clay_BoundingBox a, Clay_BoundingBox b) {
+    return a.x <= b.x + b.width && b.x <= a.x + a.width &&
+           a.y <= b.y + b.height && b.y <= a.y + a.height;
+}
+
+Clay_BoundingBox Rocks_GetCommandDamageBounds(const Clay_RenderCommand* cmd) {
+    Clay_BoundingBox bounds = cmd->boundingBox;
+
+    const RocksCustomData* custom = cmd->userData;
+    if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_RECTANGLE && custom && custom->shadowEnabled) {
+        // The blur fades out by three sigma, and sigma is half the blur radius
+        float reach = fmaxf(custom->shadowBlurRadius * 1.5f + custom->shadowSpread, 0.0f);
+        Clay_BoundingBox shadow = {
+            bounds.x + custom->shadowOffset.x - reach,
+            bounds.y + custom->shadowOffset.y - reach,
+            bounds.width + 2 * reach,
+            bounds.height + 2 * reach
+        };
+        bounds = UnionBox(bounds, shadow);
+    }
+
+    bounds.x -= ROCKS_DAMAGE_FRINGE;
+    bounds.y -= ROCKS_DAMAGE_FRINGE;
+    bounds.width += 2 * ROCKS_DAMAGE_FRINGE;
+    bounds.height += 2 * ROCKS_DAMAGE_FRINGE;
+    return bounds;
+}
+
+static uint32_t SlotFor(uint32_t id, uint8_t type, uint32_t mask) {
+    return ((id ^ ((uint32_t)type << 28)) * 2654435761u) & mask;
+}
+
+static bool RebuildIndex(Rocks_DamageTracker* tracker) {
+    uint32_t capacity = 16;
+    while (capacity < tracker->record_count * 2) capacity *= 2;
+
+    if (capacity != tracker->index_capacity) {
+        int32_t* index = realloc(tracker->index, capacity * sizeof(int32_t));
+        if (!index) return false;
+        tracker->index = index;
+        tracker->index_capacity = capacity;
+    }
+
+    memset(tracker->index, 0xFF, capacity * sizeof(int32_t));
+    uint32_t mask = capacity - 1;
+
+    // Linear probing keeps records with the same key in paint order, so
+    // repeated ids match their counterparts one by one
+    for (uint32_t i = 0; i < tracker->record_count; i++) {
+        uint32_t slot = SlotFor(tracker->records[i].id, tracker->records[i].type, mask);
+        while (tracker->index[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        tracker->index[slot] = (int32_t)i;
+    }
+    return true;
+}
+
+static Rocks_DamageRecord* FindUnmatched(Rocks_DamageTracker* tracker, uint32_t id, uint8_t type, int32_t* position) {
+    if (!tracker->index_capacity) return NULL;
+
+    uint32_t mask = tracker->index_capacity - 1;
+    uint32_t slot = SlotFor(id, type, mask);
+    while (tracker->index[slot] >= 0) {
+        Rocks_DamageRecord* record = &tracker->records[tracker->index[slot]];
+        if (record->id == id && record->type == type && !record->matched) {
+            *position = tracker->index[slot];
+            return record;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+static bool ReserveRecords(Rocks_DamageTracker* tracker, uint32_t count) {
+    if (count <= tracker->record_capacity) return true;
+
+    uint32_t capacity = tracker->record_capacity ? tracker->record_capacity : 256;
+    while (capacity < count) capacity *= 2;
+
+    Rocks_DamageRecord* records = realloc(tracker->records, capacity * sizeof(Rocks_DamageRecord));
+    if (!records) return false;
+    tracker->records = records;
+
+    Rocks_DamageRecord* scratch = realloc(tracker->scratch, capacity * sizeof(Rocks_DamageRecord));
+    if (!scratch) return false;
+    tracker->scratch = scratch;
+
+    tracker->record_capacity = capacity;
+    return true;
+}
+
+void Rocks_FreeDamageTracker(Rocks_DamageTracker* tracker) {
+    if (!tracker) return;
+    free(tracker->records);
+    free(tracker->scratch);
+    free(tracker->index);
+    tracker->records = NULL;
+    tracker->scratch = NULL;
+    tracker->index = NULL;
+    tracker->record_count = 0;
+    tracker->record_capacity = 0;
+    tracker->index_capacity = 0;
+    tracker->invalid = true;
+}
+
+void Rocks_InvalidateDamage(Rocks_DamageTracker* tracker) {
+    if (tracker) tracker->invalid = true;
+}
+
+void Rocks_ShiftDamage(Rocks_DamageTracker* tracker, Clay_Vector2 offset) {
+    if (!tracker) return;
+    tracker->shift.x += offset.x;
+    tracker->shift.y += offset.y;
+}
+
+// Moves the previous records along with the shifted pixels and damages the
+// strips the shift left behind
+static void ApplyShift(Rocks_DamageTracker* tracker) {
+    Clay_Vector2 shift = tracker->shift;
+    Clay_Dimensions viewport = tracker->viewport;
+    Clay_BoundingBox screen = {0, 0, viewport.width, viewport.height};
+
+    for (uint32_t i = 0; i < tracker->record_count; i++) {
+        Rocks_DamageRecord* record = &tracker->records[i];
+        if (IsEmptyBox(record->bounds)) continue;
+        record->bounds.x += shift.x;
+        record->bounds.y += shift.y;
+        record->bounds = Rocks_IntersectBox(record->bounds, screen);
+    }
+
+    if (shift.x > 0) {
+        Rocks_AddDamage(tracker, (Clay_BoundingBox){0, 0, shift.x, viewport.height});
+    } else if (shift.x < 0) {
+        Rocks_AddDamage(tracker, (Clay_BoundingBox){viewport.width + shift.x, 0, -shift.x, viewport.height});
+    }
+    if (shift.y > 0) {
+        Rocks_AddDamage(tracker, (Clay_BoundingBox){0, 0, viewport.width, shift.y});
+    } else if (shift.y < 0) {
+        Rocks_AddDamage(tracker, (Clay_BoundingBox){0, viewport.height + shift.y, viewport.width, -shift.y});
+    }
+}
+
+void Rocks_AddDamage(Rocks_DamageTracker* tracker, Clay_BoundingBox rect) {
+    if (tracker->full) return;
+
+    rect = Rocks_IntersectBox(rect, (Clay_BoundingBox){0, 0, tracker->viewport.width, tracker->viewport.height});
+    if (IsEmptyBox(rect)) return;
+
+    // Absorb every rect the new one touches; the union can reach further
+    // rects, so start over after each merge
+    for (int i = 0; i < tracker->rect_count;) {
+        if (Rocks_DamageOverlaps(tracker->rects[i], rect)) {
+            rect = UnionBox(rect, tracker->rects[i]);
+            tracker->rects[i] = tracker->rects[--tracker->rect_count];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (tracker->rect_count == ROCKS_MAX_DAMAGE_RECTS) {
+        // Out of slots: fold into the rect whose union grows the least
+        int best = 0;
+        float best_growth = INFINITY;
+        for (int i = 0; i < tracker->rect_count; i++) {
+            Clay_BoundingBox merged = UnionBox(rect, tracker->rects[i]);
+            float growth = merged.width * merged.height - tracker->rects[i].width * tracker->rects[i].height;
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        rect = UnionBox(rect, tracker->rects[best]);
+        tracker->rects[best] = tracker->rects[--tracker->rect_count];
+        Rocks_AddDamage(tracker, rect);
+        return;
+    }
+
+    tracker->rects[tracker->rect_count++] = rect;
+}
+
+void Rocks_ComputeDamage(Rocks_DamageTracker* tracker, Clay_RenderCommandArray commands, Clay_Dimensions viewport) {
+    bool full = tracker->invalid ||
+                viewport.width != tracker->viewport.width ||
+                viewport.height != tracker->viewport.height;
+
+    tracker->invalid = false;
+    tracker->viewport = viewport;
+    tracker->full = false;
+    tracker->rect_count = 0;
+
+    if (!full && (tracker->shift.x != 0 || tracker->shift.y != 0)) {
+        ApplyShift(tracker);
+    }
+    tracker->shift = (Clay_Vector2){0};
+
+    uint32_t count = commands.length > 0 ? (uint32_t)commands.length : 0;
+    if (!ReserveRecords(tracker, count)) {
+        printf("Failed to allocate damage records, redrawing everything\n");
+        tracker->record_count = 0;
+        tracker->index_capacity = 0;
+        tracker->invalid = true;
+        full = true;
+    }
+
+    Clay_BoundingBox clip_stack[ROCKS_MAX_DAMAGE_CLIP_DEPTH];
+    int clip_depth = 0;
+    Clay_BoundingBox clip = {0, 0, viewport.width, viewport.height};
+    int32_t last_position = -1;
+
+    for (uint32_t i = 0; i < count && !tracker->invalid; i++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, (int32_t)i);
+        Rocks_DamageRecord* record = &tracker->scratch[i];
+
+        *record = (Rocks_DamageRecord){
+            .hash = HashCommand(tracker, cmd),
+            .bounds = Rocks_IntersectBox(Rocks_GetCommandDamageBounds(cmd), clip),
+            .id = cmd->id,
+            .type = (uint8_t)cmd->commandType
+        };
+
+        // Content drawn inside a scissor only damages what the clip shows
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            if (clip_depth < ROCKS_MAX_DAMAGE_CLIP_DEPTH) clip_stack[clip_depth] = clip;
+            clip_depth++;
+            clip = Rocks_IntersectBox(clip, cmd->boundingBox);
+        } else if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END && clip_depth > 0) {
+            clip_depth--;
+            clip = clip_depth < ROCKS_MAX_DAMAGE_CLIP_DEPTH ?
+                clip_stack[clip_depth] : (Clay_BoundingBox){0, 0, viewport.width, viewport.height};
+        }
+
+        if (full) continue;
+
+        int32_t position = -1;
+        Rocks_DamageRecord* previous = FindUnmatched(tracker, record->id, record->type, &position);
+        if (!previous) {
+            Rocks_AddDamage(tracker, record->bounds);
+            continue;
+        }
+
+        previous->matched = true;
+
+        // A command that now paints before one it used to follow changes
+        // what ends up on top
+        bool reordered = position < last_position;
+        if (position > last_position) last_position = position;
+
+        if (reordered || previous->hash != record->hash || !SameBox(previous->bounds, record->bounds)) {
+            Rocks_AddDamage(tracker, previous->bounds);
+            Rocks_AddDamage(tracker, record->bounds);
+        }
+    }
+
+    if (tracker->invalid) {
+        full = true;
+    } else {
+        if (!full) {
+            for (uint32_t i = 0; i < tracker->record_count; i++) {
+                if (!tracker->records[i].matched) {
+                    Rocks_AddDamage(tracker, tracker->records[i].bounds);
+                }
+            }
+        }
+
+        Rocks_DamageRecord* swap = tracker->records;
+        tracker->records = tracker->scratch;
+        tracker->scratch = swap;
+        tracker->record_count = count;
+
+        if (!RebuildIndex(tracker)) {
+            tracker->record_count = 0;
+            tracker->index_capacity = 0;
+            tracker->invalid = true;
+        }
+    }
+
+    float area = 0;
+    for (int i = 0; i < tracker->rect_count; i++) {
+        area += tracker->rects[i].width * tracker->rects[i].height;
+    }
+    if (area > viewport.width * viewport.height * ROCKS_DAMAGE_FULL_RATIO) {
+        full = true;
+    }
+
+    if (full) {
+        tracker->full = true;
+        tracker->rects[0] = (Clay_BoundingBox){0, 0, viewport.width, viewport.height};
+        tracker->rect_count = 1;
+    }
+}
@@ -0,0 +1,79 @@
+#include "rocks_font_metrics.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ROCKS_BYTES(value) (0x0101010101010101ULL * (value))
+
+bool Rocks_IsPrintableAscii(Clay_StringSlice text) {
+    const unsigned char* chars = (const unsigned char*)text.chars;
+    int32_t i = 0;
+
+    // Eight bytes at a time: reject bytes >= 0x80, < 0x20 or == 0x7F
+    for (; i + 8 <= text.length; i += 8) {
+        uint64_t word;
+        memcpy(&word, chars + i, sizeof(word));
+
+        uint64_t high = word & ROCKS_BYTES(0x80);
+        uint64_t below_space = (word - ROCKS_BYTES(0x20)) & ~word & ROCKS_BYTES(0x80);
+        uint64_t del = word ^ ROCKS_BYTES(0x7F);
+        uint64_t is_del = (del - ROCKS_BYTES(0x01)) & ~del & ROCKS_BYTES(0x80);
+
+        if (high | below_space | is_del) return false;
+    }
+
+    for (; i < text.length; i++) {
+        if (chars[i] < ROCKS_ASCII_FIRST || chars[i] > ROCKS_ASCII_LAST) return false;
+    }
+
+    return true;
+}
+
+float Rocks_MeasureAsciiWidth(const Rocks_AsciiMetrics* metrics, Clay_StringSlice text) {
+    if (!metrics || text.length <= 0) return 0;
+
+    const unsigned char* chars = (const unsigned char*)text.chars;
+    const float* advances = metrics->advances;
+    int32_t length = text.length;
+
+    // Four independent accumulators keep the adds off one dependency chain
+    float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    int32_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        sum0 += advances[chars[i]];
+        sum1 += advances[chars[i + 1]];
+        sum2 += advances[chars[i + 2]];
+        sum3 += advances[chars[i + 3]];
+    }
+    for (; i < length; i++) {
+        sum0 += advances[chars[i]];
+    }
+    float pen = (sum0 + sum1) + (sum2 + sum3);
+
+    if (metrics->kerning) {
+        int kern = 0;
+        for (i = 1; i < length; i++) {
+            kern += metrics->kerning[(chars[i - 1] - ROCKS_ASCII_FIRST) * ROCKS_ASCII_COUNT +
+                                     (chars[i] - ROCKS_ASCII_FIRST)];
+        }
+        pen += kern;
+    }
+
+    // Glyph boxes may overhang the pen at either end
+    unsigned char last = chars[length - 1];
+    float left = metrics->min_x[chars[0]] < 0 ? metrics->min_x[chars[0]] : 0;
+    float right = pen - advances[last] + metrics->max_x[last];
+    if (right < pen) right = pen;
+
+    return right - left;
+}
+
+void Rocks_FreeAsciiMetrics(Rocks_AsciiMetrics* metrics) {
+    if (!metrics) return;
+    free(metrics->kerning);
+    memset(metrics, 0, sizeof(Rocks_AsciiMetrics));
+}
+
+float Rocks_FontLayoutRatio(bool sdf, float font_size, float base_size, float scale_factor) {
+    if (sdf) return base_size > 0 ? font_size / base_size : 0;
+    return scale_factor > 0 ? 1.0f / scale_factor : 1.0f;
+}
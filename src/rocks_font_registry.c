@@ -0,0 +1,123 @@
+#include "rocks_font_registry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static Rocks_FontFace* g_rocks_font_faces = NULL;
+
+static unsigned char* ReadFontFile(const char* path, size_t* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (length <= 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char* data = malloc(length);
+    if (!data) {
+        fclose(file);
+        return NULL;
+    }
+
+    *size = fread(data, 1, length, file);
+    fclose(file);
+    return data;
+}
+
+Rocks_FontFace* Rocks_AcquireFontFace(const char* path) {
+    if (!path) return NULL;
+
+    for (Rocks_FontFace* face = g_rocks_font_faces; face; face = face->next) {
+        if (strcmp(face->path, path) == 0) {
+            face->ref_count++;
+            return face;
+        }
+    }
+
+    Rocks_FontFace* face = calloc(1, sizeof(Rocks_FontFace));
+    if (!face) return NULL;
+
+    face->path = malloc(strlen(path) + 1);
+    face->data = ReadFontFile(path, &face->size);
+    if (!face->path || !face->data) {
+        printf("ERROR: Could not read font file: %s\n", path);
+        free(face->path);
+        free(face->data);
+        free(face);
+        return NULL;
+    }
+
+    strcpy(face->path, path);
+    face->ref_count = 1;
+    face->next = g_rocks_font_faces;
+    g_rocks_font_faces = face;
+    return face;
+}
+
+void Rocks_ReleaseFontFace(Rocks_FontFace* face) {
+    if (!face || --face->ref_count > 0) return;
+
+    Rocks_FontFace** link = &g_rocks_font_faces;
+    while (*link && *link != face) {
+        link = &(*link)->next;
+    }
+    if (*link) *link = face->next;
+
+    free(face->path);
+    free(face->data);
+    free(face);
+}
+
+int Rocks_AcquireFontVariant(Rocks_FontVariantSet* set, int size, uint64_t frame, bool* needs_load) {
+    int victim = -1;
+    for (int i = 0; i < set->count; i++) {
+        Rocks_FontVariantSlot* slot = &set->slots[i];
+        if (slot->size == size) {
+            slot->last_frame = frame;
+            *needs_load = false;
+            return i;
+        }
+
+        // Prefer an empty slot, then the least recently used idle one
+        if (victim >= 0 && set->slots[victim].size == 0) continue;
+        if (slot->size == 0) {
+            victim = i;
+        } else if (set->count >= ROCKS_FONT_VARIANT_SOFT_LIMIT && slot->last_frame + 1 < frame &&
+                   (victim < 0 || slot->last_frame < set->slots[victim].last_frame)) {
+            victim = i;
+        }
+    }
+
+    if (victim < 0) {
+        if (set->count == set->capacity) {
+            int capacity = set->capacity > 0 ? set->capacity * 2 : 4;
+            Rocks_FontVariantSlot* slots = realloc(set->slots, capacity * sizeof(Rocks_FontVariantSlot));
+            if (!slots) {
+                printf("ERROR: Could not grow font variants to %d sizes\n", capacity);
+                return -1;
+            }
+            set->slots = slots;
+            set->capacity = capacity;
+        }
+        victim = set->count++;
+        set->slots[victim] = (Rocks_FontVariantSlot){0};
+    }
+
+    set->slots[victim].last_frame = frame;
+    *needs_load = true;
+    return victim;
+}
+
+void Rocks_SetFontVariant(Rocks_FontVariantSet* set, int slot, int size) {
+    set->slots[slot].size = size;
+}
+
+void Rocks_FreeFontVariantSet(Rocks_FontVariantSet* set) {
+    free(set->slots);
+    *set = (Rocks_FontVariantSet){0};
+}
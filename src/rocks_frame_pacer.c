@@ -0,0 +1,92 @@
+#include "rocks_frame_pacer.h"
+#include "rocks.h"
+#include <math.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Share of the interval a frame may take before adaptive pacing slows
+// down, and the share it must drop under before speeding back up
+#define ROCKS_FRAME_PACER_SLOW_RATIO 0.95
+#define ROCKS_FRAME_PACER_FAST_RATIO 0.7
+
+void Rocks_InitFramePacer(Rocks_FramePacer* pacer, Rocks_FramePacing mode, float target_fps, float refresh_rate) {
+    float fps = target_fps > 0 ? target_fps : refresh_rate;
+    if (fps <= 0) fps = ROCKS_FRAME_PACER_DEFAULT_FPS;
+
+    *pacer = (Rocks_FramePacer){
+        .mode = mode,
+        .interval = 1.0 / fps,
+        .divisor = 1
+    };
+}
+
+void Rocks_SleepSeconds(double seconds) {
+    if (seconds <= 0) return;
+
+#if defined(ROCKS_USE_SDL2)
+    SDL_Delay((Uint32)(seconds * 1000.0));
+#elif defined(ROCKS_USE_RAYLIB)
+    WaitTime(seconds);
+#elif defined(_WIN32)
+    Sleep((DWORD)(seconds * 1000.0));
+#else
+    struct timespec duration = {
+        .tv_sec = (time_t)seconds,
+        .tv_nsec = (long)((seconds - floor(seconds)) * 1e9)
+    };
+    nanosleep(&duration, NULL);
+#endif
+}
+
+void Rocks_BeginPacedFrame(Rocks_FramePacer* pacer, double now) {
+    pacer->frame_start = now;
+}
+
+// Picks the slowest whole fraction of the base rate the recent frames need,
+// so a frame that runs long costs a steady lower rate instead of judder
+static void AdaptDivisor(Rocks_FramePacer* pacer, double work) {
+    pacer->work_average = pacer->work_average > 0 ?
+        pacer->work_average * 0.9 + work * 0.1 : work;
+
+    double budget = pacer->interval * pacer->divisor;
+    if (pacer->work_average > budget * ROCKS_FRAME_PACER_SLOW_RATIO &&
+        pacer->divisor < ROCKS_FRAME_PACER_MAX_DIVISOR) {
+        pacer->divisor++;
+    } else if (pacer->divisor > 1 &&
+               pacer->work_average < pacer->interval * (pacer->divisor - 1) * ROCKS_FRAME_PACER_FAST_RATIO) {
+        pacer->divisor--;
+    }
+}
+
+void Rocks_EndPacedFrame(Rocks_FramePacer* pacer) {
+    if (pacer->mode == ROCKS_FRAME_PACING_UNCAPPED || pacer->mode == ROCKS_FRAME_PACING_VSYNC) return;
+
+    double now = Rocks_GetTime(GRocks);
+    if (pacer->mode == ROCKS_FRAME_PACING_ADAPTIVE) {
+        AdaptDivisor(pacer, now - pacer->frame_start);
+    }
+
+    double interval = pacer->interval * pacer->divisor;
+    pacer->next_deadline += interval;
+
+    // A late frame goes out at once and the schedule restarts from it,
+    // rather than rushing out frames to catch up after a stall or idle wait
+    if (pacer->next_deadline <= now) {
+        pacer->next_deadline = now;
+        return;
+    }
+    if (pacer->next_deadline > now + interval) {
+        pacer->next_deadline = now + interval;
+    }
+
+    for (;;) {
+        double remaining = pacer->next_deadline - Rocks_GetTime(GRocks);
+        if (remaining <= 0) break;
+        if (remaining > ROCKS_FRAME_PACER_SPIN_MARGIN) {
+            Rocks_SleepSeconds(remaining - ROCKS_FRAME_PACER_SPIN_MARGIN);
+        }
+    }
+}
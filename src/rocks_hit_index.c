@@ -0,0 +1,164 @@
+#include "rocks_hit_index.h"
+#include "rocks_damage.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool Reserve(void** buffer, int32_t* capacity, int32_t needed, size_t item_size) {
+    if (needed <= *capacity) return true;
+
+    int32_t grown = *capacity > 0 ? *capacity : 64;
+    while (grown < needed) grown *= 2;
+
+    void* memory = realloc(*buffer, grown * item_size);
+    if (!memory) {
+        printf("Failed to grow the hit index to %d items\n", grown);
+        return false;
+    }
+    *buffer = memory;
+    *capacity = grown;
+    return true;
+}
+
+static uint32_t GetHitFlags(const RocksCustomData* data) {
+    uint32_t flags = 0;
+    if (data->cursorPointer) flags |= ROCKS_HIT_CURSOR_POINTER;
+    if (data->link) flags |= ROCKS_HIT_LINK;
+    return flags;
+}
+
+static void GetCellRange(const Rocks_HitIndex* index, Clay_BoundingBox box, int* x0, int* y0, int* x1, int* y1) {
+    *x0 = (int)(box.x / index->cell_width);
+    *y0 = (int)(box.y / index->cell_height);
+    *x1 = (int)((box.x + box.width) / index->cell_width);
+    *y1 = (int)((box.y + box.height) / index->cell_height);
+    if (*x1 >= index->columns) *x1 = index->columns - 1;
+    if (*y1 >= index->rows) *y1 = index->rows - 1;
+}
+
+void Rocks_FreeHitIndex(Rocks_HitIndex* index) {
+    free(index->entries);
+    free(index->cell_start);
+    free(index->cell_entries);
+    *index = (Rocks_HitIndex){0};
+}
+
+void Rocks_BuildHitIndex(Rocks_HitIndex* index, Clay_RenderCommandArray commands, Clay_Dimensions viewport) {
+    index->entry_count = 0;
+    index->columns = 0;
+    index->rows = 0;
+
+    Clay_BoundingBox screen = {0, 0, viewport.width, viewport.height};
+    Clay_BoundingBox clip_stack[ROCKS_MAX_HIT_CLIP_DEPTH];
+    int clip_depth = 0;
+    Clay_BoundingBox clip = screen;
+
+    for (int32_t i = 0; i < commands.length; i++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, i);
+
+        // Content scrolled out of a container cannot be pointed at
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            if (clip_depth < ROCKS_MAX_HIT_CLIP_DEPTH) clip_stack[clip_depth] = clip;
+            clip_depth++;
+            clip = Rocks_IntersectBox(clip, cmd->boundingBox);
+            continue;
+        }
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+            if (clip_depth > 0) {
+                clip_depth--;
+                clip = clip_depth < ROCKS_MAX_HIT_CLIP_DEPTH ? clip_stack[clip_depth] : screen;
+            }
+            continue;
+        }
+
+        if (!cmd->userData) continue;
+        uint32_t flags = GetHitFlags(cmd->userData);
+        if (!flags) continue;
+
+        Clay_BoundingBox bounds = Rocks_IntersectBox(cmd->boundingBox, clip);
+        if (bounds.width <= 0 || bounds.height <= 0) continue;
+
+        if (!Reserve((void**)&index->entries, &index->entry_capacity, index->entry_count + 1, sizeof(Rocks_HitEntry))) {
+            break;
+        }
+        index->entries[index->entry_count++] = (Rocks_HitEntry){
+            .bounds = bounds,
+            .data = cmd->userData,
+            .id = cmd->id,
+            .flags = flags
+        };
+    }
+
+    if (index->entry_count == 0 || viewport.width <= 0 || viewport.height <= 0) return;
+
+    int columns = (int)ceilf(viewport.width / ROCKS_HIT_GRID_MIN_CELL);
+    int rows = (int)ceilf(viewport.height / ROCKS_HIT_GRID_MIN_CELL);
+    if (columns > ROCKS_HIT_GRID_MAX_CELLS) columns = ROCKS_HIT_GRID_MAX_CELLS;
+    if (rows > ROCKS_HIT_GRID_MAX_CELLS) rows = ROCKS_HIT_GRID_MAX_CELLS;
+
+    int32_t cell_count = columns * rows;
+    if (!Reserve((void**)&index->cell_start, &index->cell_capacity, cell_count + 1, sizeof(int32_t))) {
+        return;
+    }
+    index->columns = columns;
+    index->rows = rows;
+    index->cell_width = viewport.width / columns;
+    index->cell_height = viewport.height / rows;
+
+    // Count per cell, turn the counts into offsets, then fill in paint order
+    memset(index->cell_start, 0, (cell_count + 1) * sizeof(int32_t));
+    for (int32_t i = 0; i < index->entry_count; i++) {
+        int x0, y0, x1, y1;
+        GetCellRange(index, index->entries[i].bounds, &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                index->cell_start[y * columns + x + 1]++;
+            }
+        }
+    }
+    for (int32_t cell = 0; cell < cell_count; cell++) {
+        index->cell_start[cell + 1] += index->cell_start[cell];
+    }
+
+    if (!Reserve((void**)&index->cell_entries, &index->cell_entry_capacity,
+                 index->cell_start[cell_count], sizeof(int32_t))) {
+        index->columns = 0;
+        index->rows = 0;
+        return;
+    }
+
+    // cell_start[cell] advances as the cell fills, ending where the next
+    // cell begins; shifting back afterwards restores the offsets
+    for (int32_t i = 0; i < index->entry_count; i++) {
+        int x0, y0, x1, y1;
+        GetCellRange(index, index->entries[i].bounds, &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                index->cell_entries[index->cell_start[y * columns + x]++] = i;
+            }
+        }
+    }
+    memmove(index->cell_start + 1, index->cell_start, cell_count * sizeof(int32_t));
+    index->cell_start[0] = 0;
+}
+
+const Rocks_HitEntry* Rocks_HitTest(const Rocks_HitIndex* index, float x, float y, uint32_t flags) {
+    if (index->columns == 0 || x < 0 || y < 0) return NULL;
+
+    int column = (int)(x / index->cell_width);
+    int row = (int)(y / index->cell_height);
+    if (column >= index->columns || row >= index->rows) return NULL;
+
+    int32_t cell = row * index->columns + column;
+    for (int32_t i = index->cell_start[cell + 1] - 1; i >= index->cell_start[cell]; i--) {
+        const Rocks_HitEntry* entry = &index->entries[index->cell_entries[i]];
+        if (!(entry->flags & flags)) continue;
+
+        if (x >= entry->bounds.x && x <= entry->bounds.x + entry->bounds.width &&
+            y >= entry->bounds.y && y <= entry->bounds.y + entry->bounds.height) {
+            return entry;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,214 @@
+#include "rocks_layer.h"
+#include "rocks_custom.h"
+#include <string.h>
+
+static bool ContainsBox(Clay_BoundingBox outer, Clay_BoundingBox inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+bool Rocks_FindLayerSpan(
+    Clay_RenderCommandArray* commands,
+    int32_t index,
+    Rocks_DamageHashFunction extra_hash,
+    void* userData,
+    Rocks_LayerSpan* span
+) {
+    Clay_RenderCommand* root = Clay_RenderCommandArray_Get(commands, index);
+    if (!root || !root->userData) return false;
+
+    // Borders and clip ends come after an element's children, so they never
+    // start its layer
+    if (root->commandType == CLAY_RENDER_COMMAND_TYPE_BORDER ||
+        root->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+        return false;
+    }
+
+    const RocksCustomData* custom = root->userData;
+    if (!custom->cachedLayer) return false;
+
+    // The layer starts at the element's first command, whichever type that
+    // is, so a transparent element that only clips is cached too
+    Clay_RenderCommand* previous = index > 0 ? Clay_RenderCommandArray_Get(commands, index - 1) : NULL;
+    if (previous && previous->id == root->id) return false;
+
+    // A root that clips its own children ends where that clip does
+    bool clipsSelf = root->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START;
+    int depth = clipsSelf ? 1 : 0;
+    int32_t balanced_end = index + 1;
+
+    for (int32_t end = index + 1; end < commands->length; end++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(commands, end);
+        if (cmd->zIndex != root->zIndex) break;
+
+        // Scrolled content may sit anywhere inside a clip, so only commands
+        // outside every clip have to stay within the root
+        if (depth == 0 && !ContainsBox(root->boundingBox, cmd->boundingBox)) break;
+
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            depth++;
+        } else if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+            if (depth == 0) break;
+            depth--;
+        }
+
+        if (depth == 0) {
+            balanced_end = end + 1;
+            if (clipsSelf) break;
+        }
+    }
+    if (clipsSelf && balanced_end == index + 1) return false;
+
+    Clay_BoundingBox bounds = Rocks_GetCommandDamageBounds(root);
+    uint64_t hash = ROCKS_DAMAGE_HASH_SEED;
+
+    for (int32_t i = index; i < balanced_end; i++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(commands, i);
+        uint64_t content = Rocks_HashRenderCommand(cmd);
+        Clay_BoundingBox relative = {
+            cmd->boundingBox.x - bounds.x,
+            cmd->boundingBox.y - bounds.y,
+            cmd->boundingBox.width,
+            cmd->boundingBox.height
+        };
+        uint8_t type = (uint8_t)cmd->commandType;
+
+        hash = Rocks_DamageHash(hash, &content, sizeof(content));
+        hash = Rocks_DamageHash(hash, &relative, sizeof(relative));
+        hash = Rocks_DamageHash(hash, &type, sizeof(type));
+        if (extra_hash) {
+            uint64_t extra = extra_hash(cmd, userData);
+            hash = Rocks_DamageHash(hash, &extra, sizeof(extra));
+        }
+    }
+
+    *span = (Rocks_LayerSpan){
+        .first = index,
+        .count = balanced_end - index,
+        .id = root->id,
+        .hash = hash,
+        .bounds = bounds
+    };
+    return true;
+}
+
+bool Rocks_FindScrollSpan(Clay_RenderCommandArray* commands, int32_t index, Rocks_LayerSpan* span) {
+    Clay_RenderCommand* root = Clay_RenderCommandArray_Get(commands, index);
+    if (!root || root->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) return false;
+    if (!root->renderData.scroll.horizontal && !root->renderData.scroll.vertical) return false;
+
+    int depth = 0;
+    for (int32_t end = index + 1; end < commands->length; end++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(commands, end);
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            depth++;
+        } else if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+            if (depth > 0) {
+                depth--;
+                continue;
+            }
+            // The container's own background and border sit inside its clip
+            // but do not scroll, so they stay out of the span
+            int32_t first = index + 1;
+            int32_t last = end;
+            Clay_RenderCommand* background = Clay_RenderCommandArray_Get(commands, first);
+            if (first < last && background->id == root->id &&
+                background->commandType == CLAY_RENDER_COMMAND_TYPE_RECTANGLE) {
+                first++;
+            }
+            Clay_RenderCommand* border = Clay_RenderCommandArray_Get(commands, last - 1);
+            if (first < last && border->id == root->id &&
+                border->commandType == CLAY_RENDER_COMMAND_TYPE_BORDER) {
+                last--;
+            }
+            if (first == last) return false;
+
+            *span = (Rocks_LayerSpan){
+                .first = first,
+                .count = last - first,
+                .id = root->id,
+                .bounds = root->boundingBox
+            };
+            return true;
+        }
+    }
+    return false;
+}
+
+static Rocks_LayerSlot* GetLayerSlot(Rocks_LayerTable* table, int index) {
+    return (Rocks_LayerSlot*)((char*)table->entries + index * table->entry_size);
+}
+
+void Rocks_InitLayerTable(Rocks_LayerTable* table, void* entries, size_t entry_size, Rocks_LayerReleaseFunction release) {
+    *table = (Rocks_LayerTable){
+        .entries = entries,
+        .entry_size = entry_size,
+        .release = release
+    };
+}
+
+void Rocks_ClearLayerTable(Rocks_LayerTable* table) {
+    for (int i = 0; i < table->count; i++) {
+        table->release(GetLayerSlot(table, i));
+    }
+    table->count = 0;
+}
+
+void Rocks_BeginLayerTableFrame(Rocks_LayerTable* table) {
+    table->frame++;
+
+    for (int i = 0; i < table->count;) {
+        Rocks_LayerSlot* slot = GetLayerSlot(table, i);
+        if (table->frame - slot->last_used_frame > ROCKS_LAYER_MAX_AGE) {
+            table->release(slot);
+            memcpy(slot, GetLayerSlot(table, --table->count), table->entry_size);
+        } else {
+            i++;
+        }
+    }
+}
+
+void Rocks_InvalidateLayerTable(Rocks_LayerTable* table) {
+    for (int i = 0; i < table->count; i++) {
+        GetLayerSlot(table, i)->dirty = true;
+    }
+}
+
+void* Rocks_AcquireLayerEntry(Rocks_LayerTable* table, uint32_t id, bool scrolls) {
+    Rocks_LayerSlot* slot = NULL;
+    Rocks_LayerSlot* victim = NULL;
+    for (int i = 0; i < table->count; i++) {
+        Rocks_LayerSlot* entry = GetLayerSlot(table, i);
+        if (entry->id == id && entry->scrolls == scrolls) {
+            slot = entry;
+            break;
+        }
+        if (!victim || entry->last_used_frame < victim->last_used_frame) {
+            victim = entry;
+        }
+    }
+
+    if (!slot) {
+        if (table->count < ROCKS_MAX_CACHED_LAYERS) {
+            slot = GetLayerSlot(table, table->count++);
+        } else if (victim->last_used_frame == table->frame) {
+            return NULL;
+        } else {
+            table->release(victim);
+            slot = victim;
+        }
+        memset(slot, 0, table->entry_size);
+        *slot = (Rocks_LayerSlot){ .id = id, .scrolls = scrolls, .dirty = true };
+    }
+
+    slot->last_used_frame = table->frame;
+    return slot;
+}
+
+bool Rocks_TakeLayerStale(Rocks_LayerSlot* slot, uint64_t hash) {
+    bool stale = slot->dirty || slot->hash != hash;
+    slot->dirty = false;
+    slot->hash = hash;
+    return stale;
+}
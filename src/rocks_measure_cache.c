@@ -0,0 +1,179 @@
+#include "rocks_measure_cache.h"
+#include "rocks_pipeline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+Rocks_MeasureCache g_rocks_measure_cache = {0};
+
+static uint64_t HashSlice(Clay_StringSlice text, Clay_TextElementConfig* config) {
+    uint64_t hash = 14695981039346656037ULL;
+    hash ^= config->letterSpacing;
+    hash *= 1099511628211ULL;
+
+    for (int32_t i = 0; i < text.length; i++) {
+        hash ^= (unsigned char)text.chars[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash ? hash : 1;
+}
+
+static void InsertEntry(Rocks_MeasureCacheEntry* entries, uint32_t capacity, Rocks_MeasureCacheEntry entry) {
+    uint32_t mask = capacity - 1;
+    uint32_t slot = (uint32_t)entry.hash & mask;
+    while (entries[slot].hash) {
+        slot = (slot + 1) & mask;
+    }
+    entries[slot] = entry;
+}
+
+static bool Rehash(Rocks_MeasureCache* cache, uint32_t capacity) {
+    Rocks_MeasureCacheEntry* entries = cache->scratch;
+    Rocks_MeasureCacheEntry* scratch = NULL;
+
+    if (capacity != cache->capacity) {
+        entries = malloc(capacity * sizeof(Rocks_MeasureCacheEntry));
+        scratch = malloc(capacity * sizeof(Rocks_MeasureCacheEntry));
+        if (!entries || !scratch) {
+            free(entries);
+            free(scratch);
+            return false;
+        }
+    }
+
+    memset(entries, 0, capacity * sizeof(Rocks_MeasureCacheEntry));
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < cache->capacity; i++) {
+        Rocks_MeasureCacheEntry* entry = &cache->entries[i];
+        if (!entry->hash || cache->frame - entry->last_used_frame > cache->max_age) continue;
+        InsertEntry(entries, capacity, *entry);
+        count++;
+    }
+
+    if (capacity != cache->capacity) {
+        free(cache->entries);
+        free(cache->scratch);
+        cache->scratch = scratch;
+    } else {
+        cache->scratch = cache->entries;
+    }
+
+    cache->entries = entries;
+    cache->capacity = capacity;
+    cache->count = count;
+    return true;
+}
+
+static Clay_Dimensions MeasureTextCached(Rocks_MeasureCache* cache, Clay_StringSlice text, Clay_TextElementConfig* config) {
+    if (!cache->entries) return cache->measure(text, config, cache->user_data);
+
+    uint64_t hash = HashSlice(text, config);
+    uint32_t mask = cache->capacity - 1;
+    uint32_t slot = (uint32_t)hash & mask;
+
+    while (cache->entries[slot].hash) {
+        Rocks_MeasureCacheEntry* entry = &cache->entries[slot];
+        if (entry->hash == hash &&
+            entry->length == text.length &&
+            entry->font_id == config->fontId &&
+            entry->font_size == config->fontSize) {
+            entry->last_used_frame = cache->frame;
+            cache->hits++;
+            return entry->dimensions;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    cache->misses++;
+    Clay_Dimensions dimensions = cache->measure(text, config, cache->user_data);
+
+    // A full table keeps serving hits; room is made at the next frame start
+    if ((cache->count + 1) * 4 <= cache->capacity * 3) {
+        cache->entries[slot] = (Rocks_MeasureCacheEntry){
+            .hash = hash,
+            .last_used_frame = cache->frame,
+            .length = text.length,
+            .font_id = config->fontId,
+            .font_size = config->fontSize,
+            .dimensions = dimensions
+        };
+        cache->count++;
+    }
+
+    return dimensions;
+}
+
+// Measuring may load font sizes the drawing thread is using, and fonts
+// changing on the main thread clear the table, so both run under the
+// font lock
+static Clay_Dimensions Rocks_MeasureTextCached(Clay_StringSlice text, Clay_TextElementConfig* config, void* userData) {
+    Rocks_MeasureCache* cache = (Rocks_MeasureCache*)userData;
+    if (!cache->measure) return (Clay_Dimensions){0, 0};
+
+    Rocks_LockFonts();
+    Clay_Dimensions dimensions = MeasureTextCached(cache, text, config);
+    Rocks_UnlockFonts();
+    return dimensions;
+}
+
+bool Rocks_InitMeasureCache(uint32_t capacity) {
+    Rocks_MeasureCache* cache = &g_rocks_measure_cache;
+    Rocks_CleanupMeasureCache();
+
+    // Capacity must be a power of two for the probe mask
+    uint32_t rounded = 16;
+    while (rounded < capacity) rounded <<= 1;
+
+    cache->entries = calloc(rounded, sizeof(Rocks_MeasureCacheEntry));
+    cache->scratch = calloc(rounded, sizeof(Rocks_MeasureCacheEntry));
+    if (!cache->entries || !cache->scratch) {
+        printf("Measure cache allocation failed, measuring uncached\n");
+        free(cache->entries);
+        free(cache->scratch);
+        cache->entries = NULL;
+        cache->scratch = NULL;
+        return false;
+    }
+
+    cache->capacity = rounded;
+    cache->max_age = ROCKS_MEASURE_CACHE_MAX_AGE;
+    return true;
+}
+
+void Rocks_CleanupMeasureCache(void) {
+    free(g_rocks_measure_cache.entries);
+    free(g_rocks_measure_cache.scratch);
+    g_rocks_measure_cache = (Rocks_MeasureCache){0};
+}
+
+void Rocks_SetMeasureTextFunction(Rocks_MeasureTextFunction measure, void* userData) {
+    g_rocks_measure_cache.measure = measure;
+    g_rocks_measure_cache.user_data = userData;
+    Rocks_ClearMeasureCache();
+    Clay_SetMeasureTextFunction(Rocks_MeasureTextCached, &g_rocks_measure_cache);
+}
+
+void Rocks_BeginMeasureCacheFrame(void) {
+    Rocks_MeasureCache* cache = &g_rocks_measure_cache;
+    cache->frame++;
+    if (!cache->entries) return;
+
+    bool crowded = cache->count * 4 >= cache->capacity * 3;
+    if (!crowded && cache->frame % cache->max_age != 0) return;
+
+    // Drop stale entries, then grow if the survivors still crowd the table
+    Rehash(cache, cache->capacity);
+    if (cache->count * 2 > cache->capacity) {
+        Rehash(cache, cache->capacity * 2);
+    }
+}
+
+void Rocks_ClearMeasureCache(void) {
+    Rocks_MeasureCache* cache = &g_rocks_measure_cache;
+    if (cache->entries) {
+        memset(cache->entries, 0, cache->capacity * sizeof(Rocks_MeasureCacheEntry));
+    }
+    cache->count = 0;
+}
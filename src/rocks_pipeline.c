@@ -0,0 +1,219 @@
+#include "rocks_pipeline.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static pthread_mutex_t g_rocks_font_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// Only the drawing thread ever sets this
+static _Thread_local const Rocks_PipelineFrame* g_rocks_drawn_frame = NULL;
+
+// Worker handshake: the main thread raises `pending`, the worker clears it
+// once the job has run
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    Rocks_PipelineJob job;
+    void* user_data;
+    bool running;
+    bool pending;
+    bool stopping;
+} Rocks_PipelineWorker;
+
+static Rocks_PipelineWorker g_rocks_pipeline = {0};
+
+bool Rocks_InitPipelineFrame(Rocks_PipelineFrame* frame, size_t arena_size) {
+    *frame = (Rocks_PipelineFrame){0};
+    return Rocks_InitFrameArena(&frame->arena, arena_size);
+}
+
+void Rocks_FreePipelineFrame(Rocks_PipelineFrame* frame) {
+    free(frame->commands);
+    free(frame->text);
+    free(frame->scrolls);
+    Rocks_FreeFrameArena(&frame->arena);
+    *frame = (Rocks_PipelineFrame){0};
+}
+
+static bool Reserve(void** buffer, size_t* capacity, size_t needed, size_t item_size) {
+    if (needed <= *capacity) return true;
+
+    size_t grown = *capacity > 0 ? *capacity : 64;
+    while (grown < needed) grown *= 2;
+
+    void* memory = realloc(*buffer, grown * item_size);
+    if (!memory) {
+        printf("Failed to grow a pipelined frame to %zu items\n", grown);
+        return false;
+    }
+    *buffer = memory;
+    *capacity = grown;
+    return true;
+}
+
+bool Rocks_CaptureFrame(Rocks_PipelineFrame* frame, Clay_RenderCommandArray commands) {
+    frame->command_count = 0;
+    frame->scroll_count = 0;
+
+    size_t text_size = 0;
+    int32_t scroll_count = 0;
+    for (int32_t i = 0; i < commands.length; i++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, i);
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+            text_size += cmd->renderData.text.stringContents.length;
+        } else if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            scroll_count++;
+        }
+    }
+
+    size_t command_capacity = frame->command_capacity;
+    size_t scroll_capacity = frame->scroll_capacity;
+    bool reserved =
+        Reserve((void**)&frame->commands, &command_capacity, commands.length, sizeof(Clay_RenderCommand)) &&
+        Reserve((void**)&frame->text, &frame->text_capacity, text_size, 1) &&
+        Reserve((void**)&frame->scrolls, &scroll_capacity, scroll_count, sizeof(Rocks_ScrollSnapshot));
+    frame->command_capacity = (int32_t)command_capacity;
+    frame->scroll_capacity = (int32_t)scroll_capacity;
+    if (!reserved) return false;
+
+    if (commands.length > 0) {
+        memcpy(frame->commands, commands.internalArray, commands.length * sizeof(Clay_RenderCommand));
+    }
+    frame->command_count = commands.length;
+
+    // Text slices may point at strings the next update rewrites
+    size_t text_offset = 0;
+    for (int32_t i = 0; i < frame->command_count; i++) {
+        Clay_RenderCommand* cmd = &frame->commands[i];
+
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_TEXT) {
+            Clay_StringSlice* slice = &cmd->renderData.text.stringContents;
+            if (slice->length > 0) {
+                memcpy(frame->text + text_offset, slice->chars, slice->length);
+            }
+            slice->chars = frame->text + text_offset;
+            slice->baseChars = slice->chars;
+            text_offset += slice->length;
+        } else if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) {
+            Clay_ScrollContainerData data = Clay_GetScrollContainerData((Clay_ElementId){ .id = cmd->id });
+            if (!data.found) continue;
+
+            Rocks_ScrollSnapshot* scroll = &frame->scrolls[frame->scroll_count++];
+            scroll->id = cmd->id;
+            scroll->data = data;
+            scroll->position = *data.scrollPosition;
+        }
+    }
+
+    // Pointers go in last, once the array has stopped moving
+    for (int32_t i = 0; i < frame->scroll_count; i++) {
+        frame->scrolls[i].data.scrollPosition = &frame->scrolls[i].position;
+    }
+    return true;
+}
+
+Clay_RenderCommandArray Rocks_GetFrameCommands(Rocks_PipelineFrame* frame) {
+    return (Clay_RenderCommandArray){
+        .capacity = frame->command_capacity,
+        .length = frame->command_count,
+        .internalArray = frame->commands
+    };
+}
+
+void Rocks_SetDrawnFrame(const Rocks_PipelineFrame* frame) {
+    g_rocks_drawn_frame = frame;
+}
+
+const Rocks_PipelineFrame* Rocks_GetDrawnFrame(void) {
+    return g_rocks_drawn_frame;
+}
+
+static void* RunPipelineWorker(void* arg) {
+    Rocks_PipelineWorker* worker = arg;
+
+    pthread_mutex_lock(&worker->lock);
+    for (;;) {
+        while (!worker->pending && !worker->stopping) {
+            pthread_cond_wait(&worker->changed, &worker->lock);
+        }
+        if (worker->stopping) break;
+
+        pthread_mutex_unlock(&worker->lock);
+        worker->job(worker->user_data);
+        pthread_mutex_lock(&worker->lock);
+
+        worker->pending = false;
+        pthread_cond_broadcast(&worker->changed);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+bool Rocks_StartPipeline(Rocks_PipelineJob job, void* userData) {
+    Rocks_PipelineWorker* worker = &g_rocks_pipeline;
+    if (worker->running) return false;
+
+    *worker = (Rocks_PipelineWorker){
+        .job = job,
+        .user_data = userData
+    };
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->changed, NULL);
+
+    if (pthread_create(&worker->thread, NULL, RunPipelineWorker, worker) != 0) {
+        printf("Failed to start the layout thread\n");
+        pthread_cond_destroy(&worker->changed);
+        pthread_mutex_destroy(&worker->lock);
+        return false;
+    }
+    worker->running = true;
+    return true;
+}
+
+void Rocks_KickPipeline(void) {
+    Rocks_PipelineWorker* worker = &g_rocks_pipeline;
+    if (!worker->running) return;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->pending = true;
+    pthread_cond_broadcast(&worker->changed);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void Rocks_WaitPipeline(void) {
+    Rocks_PipelineWorker* worker = &g_rocks_pipeline;
+    if (!worker->running) return;
+
+    pthread_mutex_lock(&worker->lock);
+    while (worker->pending) {
+        pthread_cond_wait(&worker->changed, &worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+void Rocks_StopPipeline(void) {
+    Rocks_PipelineWorker* worker = &g_rocks_pipeline;
+    if (!worker->running) return;
+
+    Rocks_WaitPipeline();
+
+    pthread_mutex_lock(&worker->lock);
+    worker->stopping = true;
+    pthread_cond_broadcast(&worker->changed);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->changed);
+    pthread_mutex_destroy(&worker->lock);
+    *worker = (Rocks_PipelineWorker){0};
+}
+
+void Rocks_LockFonts(void) {
+    pthread_mutex_lock(&g_rocks_font_lock);
+}
+
+void Rocks_UnlockFonts(void) {
+    pthread_mutex_unlock(&g_rocks_font_lock);
+}
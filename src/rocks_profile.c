@@ -0,0 +1,113 @@
+#include "rocks_profile.h"
+
+#ifdef ROCKS_PROFILE
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Fields are relaxed atomics so a writer a full lap behind and the dump can
+// touch a slot at the same time without undefined behavior; the sequence
+// tells readers whether what they copied is whole
+typedef struct {
+    _Atomic uint64_t sequence;  // Write index + 1 once the slot is complete
+    _Atomic(const char*) name;
+    _Atomic double start;
+    _Atomic double end;
+    _Atomic uint32_t thread;
+} Rocks_ProfileEvent;
+
+// Writers claim slots with one atomic increment and publish them by
+// storing the sequence last, so recording never blocks. Old events are
+// overwritten once the ring wraps.
+static Rocks_ProfileEvent g_rocks_profile_ring[ROCKS_PROFILE_RING_SIZE];
+static _Atomic uint64_t g_rocks_profile_head = 0;
+static _Atomic uint32_t g_rocks_profile_threads = 0;
+static _Thread_local uint32_t g_rocks_profile_thread = 0;
+
+// Wall time from a monotonic clock rather than Rocks_GetTime, whose
+// headless clock only advances between frames
+double Rocks_ProfileNow(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    if (!frequency.QuadPart) QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+#endif
+}
+
+void Rocks_ProfileRecord(const char* name, double start, double end) {
+    if (!g_rocks_profile_thread) {
+        g_rocks_profile_thread = atomic_fetch_add(&g_rocks_profile_threads, 1) + 1;
+    }
+
+    uint64_t index = atomic_fetch_add_explicit(&g_rocks_profile_head, 1, memory_order_relaxed);
+    Rocks_ProfileEvent* event = &g_rocks_profile_ring[index & (ROCKS_PROFILE_RING_SIZE - 1)];
+
+    atomic_store_explicit(&event->sequence, 0, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&event->name, name, memory_order_relaxed);
+    atomic_store_explicit(&event->start, start, memory_order_relaxed);
+    atomic_store_explicit(&event->end, end, memory_order_relaxed);
+    atomic_store_explicit(&event->thread, g_rocks_profile_thread, memory_order_relaxed);
+    atomic_store_explicit(&event->sequence, index + 1, memory_order_release);
+}
+
+void Rocks_ProfileReset(void) {
+    for (uint32_t i = 0; i < ROCKS_PROFILE_RING_SIZE; i++) {
+        atomic_store_explicit(&g_rocks_profile_ring[i].sequence, 0, memory_order_relaxed);
+    }
+}
+
+bool Rocks_ProfileDump(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Failed to open profile output: %s\n", path);
+        return false;
+    }
+
+    uint64_t head = atomic_load_explicit(&g_rocks_profile_head, memory_order_acquire);
+    uint64_t first = head > ROCKS_PROFILE_RING_SIZE ? head - ROCKS_PROFILE_RING_SIZE : 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool separator = false;
+    for (uint64_t index = first; index < head; index++) {
+        Rocks_ProfileEvent* slot = &g_rocks_profile_ring[index & (ROCKS_PROFILE_RING_SIZE - 1)];
+
+        // Skip slots being written or already reused, checking again after
+        // the copy in case a writer raced it
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != index + 1) continue;
+        const char* name = atomic_load_explicit(&slot->name, memory_order_relaxed);
+        double start = atomic_load_explicit(&slot->start, memory_order_relaxed);
+        double end = atomic_load_explicit(&slot->end, memory_order_relaxed);
+        uint32_t thread = atomic_load_explicit(&slot->thread, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->sequence, memory_order_relaxed) != index + 1) continue;
+
+        // Zone names are identifiers, so they need no escaping
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                separator ? ",\n" : "",
+                name,
+                thread,
+                start * 1e6,
+                (end - start) * 1e6);
+        separator = true;
+    }
+    fprintf(file, "\n]}\n");
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+#endif // ROCKS_PROFILE
@@ -0,0 +1,145 @@
+#include "rocks_scroll_physics.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Steps longer than this (a stall, or the first step) count as this long
+#define ROCKS_SCROLL_MAX_STEP 0.1f
+
+static Rocks_ScrollBody* FindBody(Rocks_ScrollPhysics* physics, uint32_t id) {
+    for (int32_t i = 0; i < physics->count; i++) {
+        if (physics->bodies[i].id == id) return &physics->bodies[i];
+    }
+    return NULL;
+}
+
+static Rocks_ScrollBody* GetBody(Rocks_ScrollPhysics* physics, uint32_t id) {
+    Rocks_ScrollBody* body = FindBody(physics, id);
+    if (body) return body;
+
+    if (physics->count == physics->capacity) {
+        int32_t capacity = physics->capacity > 0 ? physics->capacity * 2 : 4;
+        Rocks_ScrollBody* bodies = realloc(physics->bodies, capacity * sizeof(Rocks_ScrollBody));
+        if (!bodies) {
+            printf("Failed to track scroll momentum for %d containers\n", capacity);
+            return NULL;
+        }
+        physics->bodies = bodies;
+        physics->capacity = capacity;
+    }
+
+    body = &physics->bodies[physics->count++];
+    *body = (Rocks_ScrollBody){ .id = id };
+    return body;
+}
+
+static void RemoveBody(Rocks_ScrollPhysics* physics, Rocks_ScrollBody* body) {
+    *body = physics->bodies[--physics->count];
+}
+
+static float ClampSpeed(float speed) {
+    return fminf(fmaxf(speed, -ROCKS_SCROLL_MAX_SPEED), ROCKS_SCROLL_MAX_SPEED);
+}
+
+void Rocks_FreeScrollPhysics(Rocks_ScrollPhysics* physics) {
+    free(physics->bodies);
+    *physics = (Rocks_ScrollPhysics){0};
+}
+
+void Rocks_ClampScrollPosition(Clay_ScrollContainerData* data) {
+    float scrollableWidth = data->contentDimensions.width - data->scrollContainerDimensions.width;
+    float scrollableHeight = data->contentDimensions.height - data->scrollContainerDimensions.height;
+
+    data->scrollPosition->x = CLAY__MIN(0, CLAY__MAX(data->scrollPosition->x, -scrollableWidth));
+    data->scrollPosition->y = CLAY__MIN(0, CLAY__MAX(data->scrollPosition->y, -scrollableHeight));
+}
+
+void Rocks_ScrollBy(Rocks_ScrollPhysics* physics, uint32_t id, Clay_ScrollContainerData* data, Clay_Vector2 delta) {
+    Rocks_StopScroll(physics, id);
+
+    data->scrollPosition->x += delta.x;
+    data->scrollPosition->y += delta.y;
+    Rocks_ClampScrollPosition(data);
+}
+
+void Rocks_DragScroll(Rocks_ScrollPhysics* physics, uint32_t id, Clay_ScrollContainerData* data, Clay_Vector2 delta, double time) {
+    Clay_Vector2 before = *data->scrollPosition;
+    data->scrollPosition->x += delta.x;
+    data->scrollPosition->y += delta.y;
+    Rocks_ClampScrollPosition(data);
+
+    Rocks_ScrollBody* body = GetBody(physics, id);
+    if (!body) return;
+
+    if (!body->held) {
+        // Grabbing a coasting container stops it
+        body->held = true;
+        body->velocity = (Clay_Vector2){0, 0};
+    } else {
+        float dt = fmaxf((float)(time - body->last_drag_time), 0.001f);
+        Clay_Vector2 moved = {
+            data->scrollPosition->x - before.x,
+            data->scrollPosition->y - before.y
+        };
+        // Smoothed, so one uneven event does not decide the fling
+        body->velocity.x = 0.8f * ClampSpeed(moved.x / dt) + 0.2f * body->velocity.x;
+        body->velocity.y = 0.8f * ClampSpeed(moved.y / dt) + 0.2f * body->velocity.y;
+    }
+    body->last_drag_time = time;
+}
+
+void Rocks_ReleaseScroll(Rocks_ScrollPhysics* physics, uint32_t id, double time) {
+    Rocks_ScrollBody* body = FindBody(physics, id);
+    if (!body) return;
+
+    if (time - body->last_drag_time > ROCKS_SCROLL_RELEASE_WINDOW) {
+        RemoveBody(physics, body);
+        return;
+    }
+    body->held = false;
+}
+
+void Rocks_StopScroll(Rocks_ScrollPhysics* physics, uint32_t id) {
+    Rocks_ScrollBody* body = FindBody(physics, id);
+    if (body) RemoveBody(physics, body);
+}
+
+bool Rocks_StepScrollPhysics(Rocks_ScrollPhysics* physics, double time) {
+    float dt = fminf(fmaxf((float)(time - physics->last_step_time), 0.0f), ROCKS_SCROLL_MAX_STEP);
+    physics->last_step_time = time;
+
+    // v(t) = v0 e^(-kt), so over dt the content moves v0 (1 - e^(-k dt)) / k
+    float decay = expf(-ROCKS_SCROLL_FRICTION * dt);
+    float travel = (1.0f - decay) / ROCKS_SCROLL_FRICTION;
+
+    bool moving = false;
+    for (int32_t i = physics->count - 1; i >= 0; i--) {
+        Rocks_ScrollBody* body = &physics->bodies[i];
+        if (body->held) continue;
+
+        Clay_ScrollContainerData data = Clay_GetScrollContainerData((Clay_ElementId){ .id = body->id });
+        if (!data.found) {
+            RemoveBody(physics, body);
+            continue;
+        }
+
+        Clay_Vector2 target = {
+            data.scrollPosition->x + body->velocity.x * travel,
+            data.scrollPosition->y + body->velocity.y * travel
+        };
+        *data.scrollPosition = target;
+        Rocks_ClampScrollPosition(&data);
+
+        // Running into an edge ends the motion along that axis
+        body->velocity.x = data.scrollPosition->x != target.x ? 0 : body->velocity.x * decay;
+        body->velocity.y = data.scrollPosition->y != target.y ? 0 : body->velocity.y * decay;
+
+        if (fabsf(body->velocity.x) < ROCKS_SCROLL_STOP_SPEED &&
+            fabsf(body->velocity.y) < ROCKS_SCROLL_STOP_SPEED) {
+            RemoveBody(physics, body);
+            continue;
+        }
+        moving = true;
+    }
+    return moving;
+}
@@ -0,0 +1,134 @@
+#include "rocks_scroll_registry.h"
+#include "rocks_damage.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static uint32_t HashId(uint32_t id) {
+    id ^= id >> 16;
+    id *= 0x7feb352d;
+    id ^= id >> 15;
+    return id;
+}
+
+static bool GrowEntries(Rocks_ScrollRegistry* registry) {
+    int32_t capacity = registry->capacity > 0 ? registry->capacity * 2 : 32;
+    Rocks_ScrollEntry* entries = realloc(registry->entries, capacity * sizeof(Rocks_ScrollEntry));
+    if (!entries) {
+        printf("Failed to grow the scroll registry to %d containers\n", capacity);
+        return false;
+    }
+    registry->entries = entries;
+    registry->capacity = capacity;
+    return true;
+}
+
+// Keeps the table at most half full
+static bool ReserveIndex(Rocks_ScrollRegistry* registry, int32_t count) {
+    uint32_t capacity = registry->index_capacity > 0 ? registry->index_capacity : 64;
+    while (capacity < (uint32_t)count * 2) capacity *= 2;
+
+    if (capacity != registry->index_capacity) {
+        int32_t* index = realloc(registry->index, capacity * sizeof(int32_t));
+        if (!index) {
+            printf("Failed to grow the scroll registry index to %u slots\n", capacity);
+            return false;
+        }
+        registry->index = index;
+        registry->index_capacity = capacity;
+    }
+    memset(registry->index, 0xff, registry->index_capacity * sizeof(int32_t));
+    return true;
+}
+
+void Rocks_FreeScrollRegistry(Rocks_ScrollRegistry* registry) {
+    free(registry->entries);
+    free(registry->index);
+    *registry = (Rocks_ScrollRegistry){0};
+}
+
+void Rocks_BuildScrollRegistry(Rocks_ScrollRegistry* registry, Clay_RenderCommandArray commands, Clay_Dimensions viewport) {
+    registry->count = 0;
+
+    Clay_BoundingBox screen = {0, 0, viewport.width, viewport.height};
+    int32_t open = -1;      // Innermost container whose scissor has not ended
+
+    for (int32_t i = 0; i < commands.length; i++) {
+        Clay_RenderCommand* cmd = Clay_RenderCommandArray_Get(&commands, i);
+
+        if (cmd->commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END) {
+            if (open >= 0) open = registry->entries[open].parent;
+            continue;
+        }
+        if (cmd->commandType != CLAY_RENDER_COMMAND_TYPE_SCISSOR_START) continue;
+
+        if (registry->count == registry->capacity && !GrowEntries(registry)) break;
+
+        Clay_BoundingBox clip = open >= 0 ? registry->entries[open].visible : screen;
+        registry->entries[registry->count] = (Rocks_ScrollEntry){
+            .id = cmd->id,
+            .parent = open,
+            .bounds = cmd->boundingBox,
+            .visible = Rocks_IntersectBox(cmd->boundingBox, clip)
+        };
+        open = registry->count++;
+    }
+
+    if (!ReserveIndex(registry, registry->count)) {
+        registry->index_capacity = 0;
+        return;
+    }
+
+    uint32_t mask = registry->index_capacity - 1;
+    for (int32_t i = 0; i < registry->count; i++) {
+        uint32_t slot = HashId(registry->entries[i].id) & mask;
+        while (registry->index[slot] >= 0) {
+            // A repeated id keeps its first, outermost entry
+            if (registry->entries[registry->index[slot]].id == registry->entries[i].id) break;
+            slot = (slot + 1) & mask;
+        }
+        if (registry->index[slot] < 0) registry->index[slot] = i;
+    }
+}
+
+const Rocks_ScrollEntry* Rocks_FindScrollEntry(const Rocks_ScrollRegistry* registry, uint32_t id) {
+    if (registry->index_capacity == 0) return NULL;
+
+    uint32_t mask = registry->index_capacity - 1;
+    uint32_t slot = HashId(id) & mask;
+    while (registry->index[slot] >= 0) {
+        const Rocks_ScrollEntry* entry = &registry->entries[registry->index[slot]];
+        if (entry->id == id) return entry;
+        slot = (slot + 1) & mask;
+    }
+    return NULL;
+}
+
+const Rocks_ScrollEntry* Rocks_ScrollEntryAt(const Rocks_ScrollRegistry* registry, float x, float y) {
+    // Later entries are nested deeper or drawn on top
+    for (int32_t i = registry->count - 1; i >= 0; i--) {
+        const Rocks_ScrollEntry* entry = &registry->entries[i];
+        if (x >= entry->visible.x && x <= entry->visible.x + entry->visible.width &&
+            y >= entry->visible.y && y <= entry->visible.y + entry->visible.height &&
+            entry->visible.width > 0 && entry->visible.height > 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+const Rocks_ScrollEntry* Rocks_GetScrollParent(const Rocks_ScrollRegistry* registry, const Rocks_ScrollEntry* entry) {
+    if (!entry || entry->parent < 0) return NULL;
+    return &registry->entries[entry->parent];
+}
+
+bool Rocks_CanScrollBy(const Clay_ScrollContainerData* data, Clay_Vector2 delta) {
+    // Positions run from 0 down to minus the hidden part of the content
+    float minX = fminf(data->scrollContainerDimensions.width - data->contentDimensions.width, 0);
+    float minY = fminf(data->scrollContainerDimensions.height - data->contentDimensions.height, 0);
+    Clay_Vector2 position = *data->scrollPosition;
+
+    return (delta.x > 0 && position.x < 0) || (delta.x < 0 && position.x > minX) ||
+           (delta.y > 0 && position.y < 0) || (delta.y < 0 && position.y > minY);
+}
@@ -0,0 +1,55 @@
+// Bitmap and SDF variants of one font must measure text to the same layout
+// size at any scale factor. Needs no backend: the variants are synthesized
+// from a face whose glyphs advance half their pixel size.
+#include "rocks_font_metrics.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SDF_BASE_SIZE 48
+
+static void FillMetrics(Rocks_AsciiMetrics* metrics, float pixel_size) {
+    memset(metrics, 0, sizeof(Rocks_AsciiMetrics));
+    metrics->valid = true;
+    metrics->line_height = pixel_size;
+    for (int c = ROCKS_ASCII_FIRST; c <= ROCKS_ASCII_LAST; c++) {
+        metrics->advances[c] = pixel_size * 0.5f;
+        metrics->max_x[c] = pixel_size * 0.5f;
+    }
+}
+
+int main(void) {
+    const char* chars = "Hello, world";
+    Clay_StringSlice text = { .length = (int32_t)strlen(chars), .chars = chars };
+    const float scales[] = { 1.0f, 1.5f, 2.0f };
+    const float sizes[] = { 12.0f, 16.0f, 24.0f };
+    int failures = 0;
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            float scale = scales[i];
+            float size = sizes[j];
+
+            Rocks_AsciiMetrics bitmap, sdf;
+            FillMetrics(&bitmap, size * scale);
+            FillMetrics(&sdf, SDF_BASE_SIZE);
+
+            float bitmap_ratio = Rocks_FontLayoutRatio(false, size, size * scale, scale);
+            float sdf_ratio = Rocks_FontLayoutRatio(true, size, SDF_BASE_SIZE, scale);
+            float bitmap_width = Rocks_MeasureAsciiWidth(&bitmap, text) * bitmap_ratio;
+            float sdf_width = Rocks_MeasureAsciiWidth(&sdf, text) * sdf_ratio;
+            float expected = size * 0.5f * text.length;
+
+            if (fabsf(bitmap_width - expected) > 0.01f || fabsf(sdf_width - expected) > 0.01f ||
+                fabsf(bitmap.line_height * bitmap_ratio - size) > 0.01f ||
+                fabsf(sdf.line_height * sdf_ratio - size) > 0.01f) {
+                printf("FAIL scale %.1f size %.0f: bitmap %.2f, sdf %.2f, expected %.2f\n",
+                       scale, size, bitmap_width, sdf_width, expected);
+                failures++;
+            }
+        }
+    }
+
+    printf("font_scale: %s\n", failures ? "FAIL" : "ok");
+    return failures ? 1 : 0;
+}